@@ -0,0 +1,144 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../game/hangman.h"
+#include "../game/game_pool.h"
+#include "../game/game_batch.h"
+#include "../game/word_corpus.h"
+#include "../utility/utilities.h"
+
+// plays the same games twice, once through processGuess and once through processGuessBatch,
+// checks that both end up identical and reports the guess throughput of each
+
+static uint64_t g_rng = 0x2545F4914F6CDD1DULL;
+
+static uint32_t nextRandom(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return (uint32_t) g_rng;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool sameGame(const GameState *a, const GameState *b) {
+    return strcmp(a->revealed, b->revealed) == 0 && strcmp(a->guessed, b->guessed) == 0 && a->lives == b->lives &&
+           a->shieldActive == b->shieldActive && a->superBlankPos == b->superBlankPos && a->version == b->version;
+}
+
+int main(int argc, char *argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : 100000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+    if (games <= 0 || rounds <= 0) {
+        printf("usage: %s [games] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    WordCorpus corpus;
+    int categoryCount;
+    char **categoryNames = getWordFileNames(&categoryCount);
+    if (!wordCorpusLoad(&corpus, "resources/words", categoryNames, categoryCount)) {
+        printf("[ERROR] Failed to load the word lists, run from the repository root\n");
+        return 1;
+    }
+
+    GamePool scalarPool, batchPool;
+    GameBatch batch;
+    char *guesses = malloc(games);
+    uint8_t *results = malloc(games);
+    bool *superBlankHits = malloc(games * sizeof(bool));
+    if (!superBlankHits || !gamePoolInit(&scalarPool, games) || !gamePoolInit(&batchPool, games) || !gameBatchInit(&batch, games) ||
+        !guesses || !results) {
+        printf("[ERROR] Out of memory\n");
+        return 1;
+    }
+
+    for (int i = 0; i < games; i++) {
+        GameState *game = gamePoolAcquire(&scalarPool);
+        wordCorpusStartRandomGame(&corpus, game, 6);
+        game->shieldActive = (int) (nextRandom() % 4 == 0);
+        *gamePoolAcquire(&batchPool) = *game;
+    }
+
+    double scalarTime = 0, batchTime = 0;
+    long long guessCount = 0;
+    int mismatches = 0;
+    gameBatchLoad(&batch, batchPool.games, games);
+
+    for (int round = 0; round < rounds; round++) {
+        // one valid guess per running game, shared by both sides
+        for (int i = 0; i < games; i++) {
+            GameState *game = &scalarPool.games[i];
+            guesses[i] = 0;
+            if (isGameOver(game)) continue;
+
+            char guess;
+            do {
+                guess = (char) ('a' + nextRandom() % 26);
+            } while (!validateGuess(game, guess) && game->numGuessed < 26);
+            if (!validateGuess(game, guess)) continue;
+            guesses[i] = guess;
+            guessCount++;
+        }
+
+        double start = nowSeconds();
+        for (int i = 0; i < games; i++) {
+            if (!guesses[i]) continue;
+            GameState *game = &scalarPool.games[i];
+            game->guessed[game->numGuessed++] = guesses[i];
+            game->guessed[game->numGuessed] = '\0';
+            superBlankHits[i] = processGuess(game, guesses[i]);
+        }
+        scalarTime += nowSeconds() - start;
+
+        start = nowSeconds();
+        processGuessBatch(&batch, guesses, results);
+        batchTime += nowSeconds() - start;
+
+        for (int i = 0; i < games; i++) {
+            if (guesses[i] && superBlankHits[i] != ((results[i] & GAME_BATCH_SUPER_BLANK) != 0)) mismatches++;
+        }
+    }
+
+    gameBatchStore(&batch, batchPool.games);
+
+    // guessed lists only match as sets since the batch appends in alphabetical order
+    for (int i = 0; i < games; i++) {
+        GameState *scalar = &scalarPool.games[i];
+        GameState *batched = &batchPool.games[i];
+        char sorted[MAX_GUESSED];
+        strcpy(sorted, scalar->guessed);
+        for (int a = 0; sorted[a]; a++) {
+            for (int b = a + 1; sorted[b]; b++) {
+                if (sorted[b] < sorted[a]) {
+                    char tmp = sorted[a];
+                    sorted[a] = sorted[b];
+                    sorted[b] = tmp;
+                }
+            }
+        }
+        strcpy(scalar->guessed, sorted);
+        if (!sameGame(scalar, batched) || isGameOver(scalar) != gameBatchIsOver(&batch, i)) mismatches++;
+    }
+
+    printf("%d games, %lld guesses\n", games, guessCount);
+    printf("processGuess:      %8.2f ns/guess\n", scalarTime * 1e9 / (double) guessCount);
+    printf("processGuessBatch: %8.2f ns/guess\n", batchTime * 1e9 / (double) guessCount);
+    printf("%d mismatches\n", mismatches);
+
+    gameBatchDestroy(&batch);
+    gamePoolDestroy(&scalarPool);
+    gamePoolDestroy(&batchPool);
+    wordCorpusFree(&corpus);
+    free(guesses);
+    free(results);
+    free(superBlankHits);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../game/hangman.h"
+#include "../game/word_scheduler.h"
+#include "../screens/about_section.h"
+#include "../screens/ingame_ui.h"
+#include "../screens/loading_screen.h"
+#include "../screens/main_menu.h"
+#include "../screens/graphics/texture_manager.h"
+#include "../screens/graphics/font_manager.h"
+#include "../profiling/alloc_tracker.h"
+
+// renders every screen offscreen with the software renderer for a number of frames, at a few window sizes and
+// in the states that draw the most, and prints the frame time distribution and the SDL allocations per frame
+
+#define WARMUP_FRAMES 30
+#define WARMUP_MS 300 // the about section lays text out again 150ms after a resize
+
+static const struct {
+    int w, h;
+} resolutions[] = {{800, 600}, {1280, 720}, {1920, 1080}};
+
+static SDL_Window *window;
+static SDL_Renderer *renderer;
+static GameState game;
+static WordScheduler words;
+
+// SCENARIOS
+
+static void startGame(void) {
+    initHangmanInPlace(&game, "animals", "hangman", 6);
+}
+
+static void sendKey(SDL_Keycode key) {
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_KEYDOWN;
+    event.key.keysym.sym = key;
+    ingameUiHandleEvent(&event);
+}
+
+/**
+ * Clicks the guessed letters tab, on the first pixel of its hit mask mapped back to window coordinates
+ */
+static void clickLettersTab(void) {
+    const HitMask *mask = g_ingameUITextures.lettersMask[0];
+    if (!mask) return;
+    int winW, winH;
+    SDL_GetWindowSize(window, &winW, &winH);
+
+    for (int y = 0; y < mask->h; y++) {
+        for (int x = 0; x < mask->w; x++) {
+            if (!hitMaskTest(mask, x, y)) continue;
+
+            SDL_Event event;
+            memset(&event, 0, sizeof(event));
+            event.type = SDL_MOUSEBUTTONDOWN;
+            event.button.button = SDL_BUTTON_LEFT;
+            event.button.x = (x * winW + mask->w - 1) / mask->w;
+            event.button.y = (y * winH + mask->h - 1) / mask->h;
+            ingameUiHandleEvent(&event);
+            return;
+        }
+    }
+}
+
+static bool setupLoading(void) {
+    return loadingScreenInit(window, renderer);
+}
+
+static void frameLoading(int frame) {
+    //the screen skips frames where the percentage didn't move, so every frame shows a new one
+    loadingScreenRender(renderer, window, (frame % 101) / 100.0f);
+}
+
+static bool setupMenu(void) {
+    return mainMenuInit(window, renderer);
+}
+
+static void frameMenu(int frame) {
+    MenuSnapshot snap;
+    mainMenuSnapshot(&snap);
+    int winW, winH;
+    SDL_GetWindowSize(window, &winW, &winH);
+    mainMenuRender(renderer, winW, winH, &snap);
+    SDL_RenderPresent(renderer);
+}
+
+static bool setupAbout(void) {
+    return aboutSectionInit(window, renderer);
+}
+
+static void frameAbout(int frame) {
+    int winW, winH;
+    SDL_GetWindowSize(window, &winW, &winH);
+    aboutSectionRender(renderer, winW, winH);
+    SDL_RenderPresent(renderer);
+}
+
+static bool setupIngame(void) {
+    startGame();
+    return ingameUiInit(window, &game, &words);
+}
+
+static bool setupDrawer(void) {
+    if (!setupIngame()) return false;
+    //misses only, a hit could land on the super blank and open the power ui
+    const char *guesses = "eiosu";
+    for (int i = 0; guesses[i]; i++) sendKey(guesses[i]);
+    clickLettersTab();
+    return true;
+}
+
+static bool setupPowerUi(void) {
+    if (!setupIngame()) return false;
+    ingameUiTriggerPowerup();
+    return true;
+}
+
+static bool setupGameOver(void) {
+    if (!setupIngame()) return false;
+    game.lives = 0;
+    game.version++;
+    return true;
+}
+
+static void frameIngame(int frame) {
+    static IngameSnapshot snap;
+    ingameUiUpdate(1.0f / 60.0f);
+    ingameUiSnapshot(&snap, 0.0f);
+    int winW, winH;
+    SDL_GetWindowSize(window, &winW, &winH);
+    if (ingameUiRender(renderer, winW, winH, &snap)) SDL_RenderPresent(renderer);
+}
+
+static void destroyIngame(void) {
+    ingameUiDestroy();
+    ingameUiReleaseRender();
+}
+
+typedef struct {
+    const char *name;
+    bool (*setup)(void);
+    void (*frame)(int frame);
+    void (*destroy)(void);
+} Scenario;
+
+static const Scenario scenarios[] = {
+    {"loading", setupLoading, frameLoading, loadingScreenDestroy},
+    {"menu", setupMenu, frameMenu, mainMenuDestroy},
+    {"about", setupAbout, frameAbout, aboutSectionDestroy},
+    {"ingame", setupIngame, frameIngame, destroyIngame},
+    {"drawer open", setupDrawer, frameIngame, destroyIngame},
+    {"power ui", setupPowerUi, frameIngame, destroyIngame},
+    {"game over", setupGameOver, frameIngame, destroyIngame},
+};
+
+// MEASUREMENT
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Runs one scenario at the current window size and prints a row of the report
+ *
+ * @return false if the screen failed to initialise
+ */
+static bool runScenario(const Scenario *scenario, int w, int h, int frames, double *times) {
+    if (!scenario->setup()) {
+        printf("[ERROR] %s failed to initialise\n", scenario->name);
+        return false;
+    }
+
+    Uint32 warmupStart = SDL_GetTicks();
+    int frame = 0;
+    while (frame < WARMUP_FRAMES || SDL_GetTicks() - warmupStart < WARMUP_MS) {
+        scenario->frame(frame++);
+    }
+
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    uint64_t allocations = 0, bytes = 0, objects = 0;
+    AllocCounts counts;
+    allocTrackerTake(&counts);
+    for (int i = 0; i < frames; i++) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        scenario->frame(frame++);
+        times[i] = (double) (SDL_GetPerformanceCounter() - start) * 1000.0 / frequency;
+
+        allocTrackerTake(&counts);
+        allocations += counts.allocations;
+        bytes += counts.bytes;
+        for (int o = 0; o < ALLOC_OBJECTS; o++) objects += counts.objects[o];
+    }
+    scenario->destroy();
+
+    double total = 0;
+    for (int i = 0; i < frames; i++) total += times[i];
+    qsort(times, frames, sizeof(double), compareDoubles);
+
+    char size[16];
+    snprintf(size, sizeof(size), "%dx%d", w, h);
+    printf("%-12s %-10s %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %10.2f %10.1f %8.2f\n", scenario->name, size,
+           total / frames, times[0], times[frames / 2], times[frames * 9 / 10], times[frames * 99 / 100],
+           times[frames - 1], (double) allocations / frames, (double) bytes / frames / 1024.0,
+           (double) objects / frames);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    int frames = argc > 1 ? atoi(argv[1]) : 300;
+    if (frames <= 0) frames = 1;
+
+    if (!allocTrackerInstall()) return 1;
+
+    //no window shows up, SDL_VIDEODRIVER can still pick another driver
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS) < 0) {
+        printf("[ERROR] SDL Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    if (TTF_Init() == -1) {
+        printf("[ERROR] TTF Init failed: %s\n", TTF_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    window = SDL_CreateWindow("Hangman", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                              resolutions[0].w, resolutions[0].h, SDL_WINDOW_HIDDEN);
+    renderer = window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : NULL;
+    if (!renderer) {
+        printf("[ERROR] Offscreen renderer failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    //same textures the game loads, run from the repository root
+    if (!textureManagerInit(renderer)) {
+        printf("[ERROR] Failed to load textures, run from the repository root\n");
+        return 1;
+    }
+    wordSchedulerInit(&words, 1);
+    srand(1);
+
+    //every frame is measured at full quality, slow sizes would otherwise be measured skipping frames
+    ingameUiSetQualityGovernor(false);
+
+    double *times = malloc(frames * sizeof(double));
+    if (!times) return 1;
+
+    printf("%d frames per row, times in ms, allocations through SDL and surfaces, textures and fonts created\n", frames);
+    printf("%-12s %-10s %8s %8s %8s %8s %8s %8s %10s %10s %8s\n", "screen", "size", "mean", "min", "p50", "p90", "p99",
+           "max", "allocs", "KB", "objects");
+
+    int failures = 0;
+    for (size_t r = 0; r < SDL_arraysize(resolutions); r++) {
+        SDL_SetWindowSize(window, resolutions[r].w, resolutions[r].h);
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {}
+        for (size_t s = 0; s < SDL_arraysize(scenarios); s++) {
+            if (!runScenario(&scenarios[s], resolutions[r].w, resolutions[r].h, frames, times)) failures++;
+        }
+    }
+
+    free(times);
+    textureManagerDestroyAll();
+    fontManagerDestroy();
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    TTF_Quit();
+    SDL_Quit();
+    return failures ? 1 : 0;
+}
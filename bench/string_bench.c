@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../game/hangman.h"
+#include "../game/word_corpus.h"
+#include "../utility/utilities.h"
+
+// times the string helpers of utilities.c at every SIMD level on the real word lists plus some long
+// strings, and checks that every level gives the same answers as the scalar loops
+
+#define LONG_WORDS 64
+
+static const char *levelNames[] = {"scalar", "sse2", "avx2"};
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef struct {
+    const char **words;
+    int count;
+} WordSet;
+
+// every result folded into one number so levels can be compared and the work isn't optimised away
+static unsigned long runOnce(const WordSet *set, double times[5]) {
+    unsigned long checksum = 0;
+    char buffer[MAX_WORD_LEN];
+    char revealed[MAX_WORD_LEN];
+    double start;
+
+    start = nowSeconds();
+    for (int w = 0; w < set->count; w++) {
+        for (char ch = 'a'; ch <= 'z'; ch++) checksum = checksum * 31 + stringHasChar(set->words[w], ch);
+    }
+    times[0] += nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int w = 0; w < set->count; w++) {
+        copyStringToUnderscores(revealed, set->words[w]);
+        checksum = checksum * 31 + (unsigned char) revealed[strlen(revealed) / 2];
+    }
+    times[1] += nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int w = 0; w < set->count; w++) {
+        copyStringToUnderscores(revealed, set->words[w]);
+        for (char ch = 'a'; ch <= 'z'; ch++) revealGuessedLetter(set->words[w], revealed, ch);
+        for (size_t i = 0; revealed[i]; i++) checksum = checksum * 31 + (unsigned char) revealed[i];
+    }
+    times[2] += nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int w = 0; w < set->count; w++) {
+        checksum = checksum * 31 + isWordFullyRevealed(set->words[w]);
+        copyStringToUnderscores(revealed, set->words[w]);
+        checksum = checksum * 31 + isWordFullyRevealed(revealed);
+    }
+    times[3] += nowSeconds() - start;
+
+    start = nowSeconds();
+    for (int w = 0; w < set->count; w++) {
+        strcpy(buffer, set->words[w]);
+        buffer[0] = (char) (buffer[0] & ~0x20);
+        stringToLower(buffer);
+        for (size_t i = 0; buffer[i]; i++) checksum = checksum * 31 + (unsigned char) buffer[i];
+    }
+    times[4] += nowSeconds() - start;
+
+    return checksum;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    if (iterations <= 0) iterations = 1;
+
+    WordCorpus corpus;
+    int categoryCount;
+    char **categoryNames = getWordFileNames(&categoryCount);
+    if (!wordCorpusLoad(&corpus, "resources/words", categoryNames, categoryCount)) {
+        printf("[ERROR] Failed to load the word lists, run from the repository root\n");
+        return 1;
+    }
+
+    // real words are short, the long ones show what the vector loops do when they get to run
+    static char longWords[LONG_WORDS][MAX_WORD_LEN];
+    const char **words = malloc((corpus.wordCount + LONG_WORDS) * sizeof(char *));
+    if (!words) return 1;
+    for (int i = 0; i < corpus.wordCount; i++) words[i] = wordCorpusGetWord(&corpus, i);
+    for (int i = 0; i < LONG_WORDS; i++) {
+        int len = 40 + i;
+        for (int c = 0; c < len; c++) longWords[i][c] = (char) ('a' + (c * 7 + i) % 26);
+        longWords[i][len] = '\0';
+        words[corpus.wordCount + i] = longWords[i];
+    }
+    WordSet sets[2] = {{words, corpus.wordCount}, {words + corpus.wordCount, LONG_WORDS}};
+    const char *setNames[2] = {"word lists", "long strings"};
+
+    SimdLevel best = setSimdLevel(SIMD_AVX2);
+    int failures = 0;
+
+    for (int s = 0; s < 2; s++) {
+        printf("%s (%d strings), ns per string:\n", setNames[s], sets[s].count);
+        printf("%-8s %10s %10s %10s %10s %10s\n", "", "hasChar", "blank", "reveal", "revealed?", "lower");
+
+        unsigned long reference = 0;
+        for (int level = SIMD_SCALAR; level <= (int) best; level++) {
+            setSimdLevel((SimdLevel) level);
+            double times[5] = {0};
+            unsigned long checksum = 0;
+            for (int it = 0; it < iterations; it++) checksum = runOnce(&sets[s], times);
+
+            if (level == SIMD_SCALAR) reference = checksum;
+            else if (checksum != reference) failures++;
+
+            printf("%-8s", levelNames[level]);
+            for (int f = 0; f < 5; f++) printf(" %10.2f", times[f] * 1e9 / ((double) iterations * sets[s].count));
+            printf("%s\n", checksum == reference ? "" : "  MISMATCH");
+        }
+        printf("\n");
+    }
+
+    setSimdLevel(best);
+    free(words);
+    wordCorpusFree(&corpus);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "corpus_watcher.h"
+#include "../utility/utilities.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define CORPUS_WATCHER_THREAD 1
+#endif
+
+// editors and copies touch a file several times, reload once it stayed quiet this long
+#define RELOAD_SETTLE_MS 200
+#define STOP_POLL_MS 250
+
+typedef struct CorpusVersion {
+    WordCorpus corpus;
+    struct CorpusVersion *next; // next retired version waiting to be freed
+} CorpusVersion;
+
+static char watchDirectory[512];
+
+#ifdef CORPUS_WATCHER_THREAD
+static _Atomic(CorpusVersion *) current = NULL;
+static _Atomic(CorpusVersion *) retired = NULL;
+static atomic_int generation = 0;
+static atomic_bool stopRequested = false;
+static pthread_t watchThread;
+static bool threadRunning = false;
+static int inotifyFd = -1;
+#else
+static CorpusVersion *current = NULL;
+static int generation = 0;
+#endif
+
+/**
+ * Scans the watched directory and loads every word file in it into a new corpus
+ *
+ * @return the new version, NULL if memory ran out. Its corpus is empty if nothing could be loaded
+ */
+static CorpusVersion *loadVersion(void) {
+    char names[MAX_WORD_FILES][MAX_WORD_FILE_NAME];
+    char *namePointers[MAX_WORD_FILES];
+    int count = listWordFiles(watchDirectory, names, MAX_WORD_FILES);
+    if (count < 0) {
+        printf("[WARNING] Failed to read word directory %s\n", watchDirectory);
+        count = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        namePointers[i] = names[i];
+    }
+
+    CorpusVersion *version = calloc(1, sizeof(CorpusVersion));
+    if (!version) return NULL;
+    wordCorpusLoad(&version->corpus, watchDirectory, namePointers, count);
+    return version;
+}
+
+static void freeVersions(CorpusVersion *version) {
+    while (version) {
+        CorpusVersion *next = version->next;
+        wordCorpusFree(&version->corpus);
+        free(version);
+        version = next;
+    }
+}
+
+#ifdef CORPUS_WATCHER_THREAD
+
+/**
+ * Loads the directory again and publishes the result, the version it replaces is retired for the reader to free
+ */
+static void reloadCorpus(void) {
+    CorpusVersion *next = loadVersion();
+    if (!next) return;
+
+    // a list that is half copied or was deleted by accident shouldn't empty the game
+    if (next->corpus.wordCount == 0) {
+        printf("[WARNING] Word lists in %s have no words, keeping the old ones\n", watchDirectory);
+        freeVersions(next);
+        return;
+    }
+
+    CorpusVersion *old = atomic_exchange(&current, next);
+    old->next = atomic_load(&retired);
+    while (!atomic_compare_exchange_weak(&retired, &old->next, old)) {
+    }
+    atomic_fetch_add(&generation, 1);
+
+    printf("Reloaded word lists: %d words in %d categories\n", next->corpus.wordCount, next->corpus.categoryCount);
+}
+
+/**
+ * Returns true if an inotify event is about a word file
+ */
+static bool isWordFileEvent(const struct inotify_event *event) {
+    if (event->mask & IN_Q_OVERFLOW) return true; // events were lost, assume the worst
+    if (event->len == 0) return false;
+    size_t len = strlen(event->name);
+    return len > 4 && strcmp(event->name + len - 4, ".txt") == 0;
+}
+
+static void *watchThreadMain(void *data) {
+    struct pollfd pollFd = {inotifyFd, POLLIN, 0};
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool pending = false;
+
+    while (!atomic_load(&stopRequested)) {
+        int ready = poll(&pollFd, 1, pending ? RELOAD_SETTLE_MS : STOP_POLL_MS);
+
+        if (ready > 0) {
+            ssize_t len = read(inotifyFd, buffer, sizeof(buffer));
+            for (char *p = buffer; len > 0 && p < buffer + len;) {
+                const struct inotify_event *event = (const struct inotify_event *) p;
+                if (isWordFileEvent(event)) pending = true;
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        } else if (ready == 0 && pending) {
+            pending = false;
+            reloadCorpus();
+        }
+    }
+    return NULL;
+}
+
+#endif
+
+/**
+ * Loads the word files of a directory and starts watching it for changes
+ *
+ * @param directory directory holding one .txt file per category
+ * @return false if no words could be loaded, the watcher still runs so lists added later are picked up
+ */
+bool corpusWatcherStart(const char *directory) {
+    snprintf(watchDirectory, sizeof(watchDirectory), "%s", directory);
+
+    CorpusVersion *first = loadVersion();
+    if (!first) return false;
+    bool loaded = first->corpus.wordCount > 0;
+
+#ifdef CORPUS_WATCHER_THREAD
+    atomic_store(&current, first);
+    atomic_store(&stopRequested, false);
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE;
+    if (inotifyFd < 0 || inotify_add_watch(inotifyFd, directory, mask) < 0) {
+        printf("[WARNING] Can't watch %s for new word lists\n", directory);
+    } else if (pthread_create(&watchThread, NULL, watchThreadMain, NULL) == 0) {
+        threadRunning = true;
+    }
+#else
+    current = first;
+#endif
+
+    return loaded;
+}
+
+/**
+ * Stops watching and frees every corpus, pointers from corpusWatcherGet become invalid
+ */
+void corpusWatcherStop(void) {
+#ifdef CORPUS_WATCHER_THREAD
+    if (threadRunning) {
+        atomic_store(&stopRequested, true);
+        pthread_join(watchThread, NULL);
+        threadRunning = false;
+    }
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    freeVersions(atomic_exchange(&retired, NULL));
+    freeVersions(atomic_exchange(&current, NULL));
+#else
+    freeVersions(current);
+    current = NULL;
+#endif
+}
+
+/**
+ * Returns the corpus to read words from
+ *
+ * @return current corpus, stays valid until the next corpusWatcherQuiesce
+ */
+const WordCorpus *corpusWatcherGet(void) {
+#ifdef CORPUS_WATCHER_THREAD
+    CorpusVersion *version = atomic_load(&current);
+#else
+    CorpusVersion *version = current;
+#endif
+    if (!version) {
+        static const WordCorpus empty;
+        return &empty;
+    }
+    return &version->corpus;
+}
+
+/**
+ * Frees corpora that were replaced by a reload. The reader calls this once per frame, after it dropped
+ * every pointer it got from corpusWatcherGet
+ */
+void corpusWatcherQuiesce(void) {
+#ifdef CORPUS_WATCHER_THREAD
+    if (atomic_load(&retired)) freeVersions(atomic_exchange(&retired, NULL));
+#endif
+}
+
+/**
+ * Tells how many reloads were swapped in, lets callers notice a new corpus
+ *
+ * @return number of reloads since corpusWatcherStart
+ */
+int corpusWatcherGeneration(void) {
+#ifdef CORPUS_WATCHER_THREAD
+    return atomic_load(&generation);
+#else
+    return generation;
+#endif
+}
@@ -0,0 +1,30 @@
+#ifndef CORPUS_WATCHER_H
+#define CORPUS_WATCHER_H
+
+#include <stdbool.h>
+
+#include "word_corpus.h"
+
+/*
+ * Keeps the word corpus of a directory up to date while the game runs. On linux a background thread waits for
+ * inotify events, loads the whole directory into a new corpus and swaps it in with one atomic store; the old
+ * corpus is freed later by corpusWatcherQuiesce. Elsewhere the corpus is loaded once.
+ *
+ * Only one thread may read the corpus: pointers from corpusWatcherGet stay valid until that thread calls
+ * corpusWatcherQuiesce
+ */
+
+bool corpusWatcherStart(const char *directory);
+
+void corpusWatcherStop(void);
+
+// current corpus, never NULL after corpusWatcherStart, may be empty if nothing could be loaded
+const WordCorpus *corpusWatcherGet(void);
+
+// frees corpora replaced since the last call, only call while holding no pointer from corpusWatcherGet
+void corpusWatcherQuiesce(void);
+
+// number of reloads swapped in so far
+int corpusWatcherGeneration(void);
+
+#endif
@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GAME_BATCH_SSE2 1
+#endif
+
+#include "game_batch.h"
+
+/**
+ * Bit of a letter inside the letter masks
+ *
+ * @param ch character to look up
+ * @return bit of the lower cased letter, 0 if ch is not a letter 'a'..'z'
+ */
+static uint32_t letterBit(char ch) {
+    ch = (char) tolower((unsigned char) ch);
+    if (ch < 'a' || ch > 'z') return 0;
+    return 1u << (ch - 'a');
+}
+
+/**
+ * Allocates the arrays of a batch, padded so the guess loop never needs a scalar tail
+ *
+ * @param batch batch to initialise
+ * @param capacity maximum number of games in the batch
+ * @return false if memory ran out
+ */
+bool gameBatchInit(GameBatch *batch, int capacity) {
+    memset(batch, 0, sizeof(GameBatch));
+    if (capacity <= 0) return false;
+
+    int padded = (capacity + GAME_BATCH_LANES - 1) / GAME_BATCH_LANES * GAME_BATCH_LANES;
+    batch->wordMask = calloc(padded, sizeof(uint32_t));
+    batch->hiddenMask = calloc(padded, sizeof(uint32_t));
+    batch->loadedHidden = calloc(padded, sizeof(uint32_t));
+    batch->guessedMask = calloc(padded, sizeof(uint32_t));
+    batch->superBlankMask = calloc(padded, sizeof(uint32_t));
+    batch->lives = calloc(padded, sizeof(int32_t));
+    batch->shield = calloc(padded, sizeof(uint32_t));
+    batch->versionDelta = calloc(padded, sizeof(uint32_t));
+    if (!batch->wordMask || !batch->hiddenMask || !batch->loadedHidden || !batch->guessedMask ||
+        !batch->superBlankMask || !batch->lives || !batch->shield || !batch->versionDelta) {
+        gameBatchDestroy(batch);
+        return false;
+    }
+
+    batch->capacity = capacity;
+    return true;
+}
+
+/**
+ * Frees the arrays of a batch
+ *
+ * @param batch batch to destroy
+ */
+void gameBatchDestroy(GameBatch *batch) {
+    free(batch->wordMask);
+    free(batch->hiddenMask);
+    free(batch->loadedHidden);
+    free(batch->guessedMask);
+    free(batch->superBlankMask);
+    free(batch->lives);
+    free(batch->shield);
+    free(batch->versionDelta);
+    memset(batch, 0, sizeof(GameBatch));
+}
+
+/**
+ * Copies games into the batch, replacing whatever it held before
+ *
+ * @param batch batch to fill
+ * @param games contiguous games, e.g. the slots of a GamePool
+ * @param count number of games
+ * @return false if count is larger than the capacity of the batch
+ */
+bool gameBatchLoad(GameBatch *batch, const GameState *games, int count) {
+    if (count < 0 || count > batch->capacity) return false;
+
+    for (int g = 0; g < count; g++) {
+        const GameState *game = &games[g];
+        uint32_t wordMask = 0, hidden = 0, guessed = 0;
+
+        for (int i = 0; game->word[i] != '\0'; i++) {
+            uint32_t bit = letterBit(game->word[i]);
+            wordMask |= bit;
+            if (game->revealed[i] == '_' || game->revealed[i] == '~') hidden |= bit ? bit : GAME_BATCH_OTHER_BIT;
+        }
+        for (int i = 0; i < game->numGuessed; i++) {
+            guessed |= letterBit(game->guessed[i]);
+        }
+
+        batch->wordMask[g] = wordMask;
+        batch->hiddenMask[g] = hidden;
+        batch->loadedHidden[g] = hidden;
+        batch->guessedMask[g] = guessed;
+        batch->superBlankMask[g] = game->superBlankPos >= 0 ? letterBit(game->word[game->superBlankPos]) : 0;
+        batch->lives[g] = game->lives;
+        batch->shield[g] = game->shieldActive ? 1 : 0;
+        batch->versionDelta[g] = 0;
+    }
+
+    // padding lanes stay inert: no word, no guesses
+    int padded = (count + GAME_BATCH_LANES - 1) / GAME_BATCH_LANES * GAME_BATCH_LANES;
+    for (int g = count; g < padded; g++) {
+        batch->wordMask[g] = batch->hiddenMask[g] = batch->loadedHidden[g] = 0;
+        batch->guessedMask[g] = batch->superBlankMask[g] = batch->shield[g] = batch->versionDelta[g] = 0;
+        batch->lives[g] = 0;
+    }
+
+    batch->count = count;
+    return true;
+}
+
+/**
+ * Writes the batch back into the games it was loaded from, leaving them as processGuess would have.
+ * Letters guessed inside the batch are appended to the guessed list in alphabetical order
+ *
+ * @param batch batch to read
+ * @param games the games passed to gameBatchLoad
+ */
+void gameBatchStore(const GameBatch *batch, GameState *games) {
+    for (int g = 0; g < batch->count; g++) {
+        GameState *game = &games[g];
+        uint32_t revealedNow = batch->loadedHidden[g] & ~batch->hiddenMask[g];
+
+        if (revealedNow) {
+            for (int i = 0; game->word[i] != '\0'; i++) {
+                if (letterBit(game->word[i]) & revealedNow) game->revealed[i] = game->word[i];
+            }
+        }
+
+        // a super blank under a letter is used up once that letter is guessed
+        if (game->superBlankPos >= 0 && batch->superBlankMask[g] == 0 &&
+            letterBit(game->word[game->superBlankPos])) {
+            game->superBlankPos = -1;
+        }
+
+        uint32_t known = 0;
+        for (int i = 0; i < game->numGuessed; i++) {
+            known |= letterBit(game->guessed[i]);
+        }
+        uint32_t added = batch->guessedMask[g] & ~known;
+        for (int letter = 0; letter < 26 && added; letter++) {
+            if (!(added & (1u << letter)) || game->numGuessed >= MAX_GUESSED - 1) continue;
+            game->guessed[game->numGuessed++] = (char) ('a' + letter);
+            added &= ~(1u << letter);
+        }
+        game->guessed[game->numGuessed] = '\0';
+
+        game->lives = batch->lives[g];
+        game->shieldActive = batch->shield[g] ? 1 : 0;
+        game->version += batch->versionDelta[g];
+    }
+}
+
+#ifdef GAME_BATCH_SSE2
+
+/**
+ * One guess for GAME_BATCH_LANES games at once, same rules as processGuess
+ *
+ * @param batch batch to update
+ * @param g index of the first game, a multiple of GAME_BATCH_LANES
+ * @param bits letter bit guessed by each game, 0 for games without a guess
+ * @return GAME_BATCH_* flags of each game, widened to 32 bits
+ */
+static __m128i guessLanes(GameBatch *batch, int g, __m128i bits) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+
+    __m128i idle = _mm_cmpeq_epi32(bits, zero);
+    __m128i word = _mm_loadu_si128((const __m128i *) &batch->wordMask[g]);
+    __m128i missed = _mm_cmpeq_epi32(_mm_and_si128(word, bits), zero);
+    __m128i superBlank = _mm_loadu_si128((const __m128i *) &batch->superBlankMask[g]);
+    __m128i hitSuperBlank = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(superBlank, bits), zero), _mm_set1_epi32(-1));
+
+    // a guessed letter is revealed everywhere, clearing the bit is a no-op for letters the word doesn't have
+    __m128i *hidden = (__m128i *) &batch->hiddenMask[g];
+    _mm_storeu_si128(hidden, _mm_andnot_si128(bits, _mm_loadu_si128(hidden)));
+    _mm_storeu_si128((__m128i *) &batch->superBlankMask[g], _mm_andnot_si128(bits, superBlank));
+    __m128i *guessed = (__m128i *) &batch->guessedMask[g];
+    _mm_storeu_si128(guessed, _mm_or_si128(_mm_loadu_si128(guessed), bits));
+
+    // a miss eats the shield if there is one, a life otherwise
+    __m128i miss = _mm_andnot_si128(idle, missed);
+    __m128i *shield = (__m128i *) &batch->shield[g];
+    __m128i shieldValue = _mm_loadu_si128(shield);
+    __m128i noShield = _mm_cmpeq_epi32(shieldValue, zero);
+    _mm_storeu_si128(shield, _mm_andnot_si128(miss, shieldValue));
+    __m128i *lives = (__m128i *) &batch->lives[g];
+    _mm_storeu_si128(lives, _mm_add_epi32(_mm_loadu_si128(lives), _mm_and_si128(miss, noShield)));
+
+    __m128i *version = (__m128i *) &batch->versionDelta[g];
+    _mm_storeu_si128(version, _mm_add_epi32(_mm_loadu_si128(version), _mm_andnot_si128(idle, one)));
+
+    __m128i found = _mm_andnot_si128(missed, one);
+    __m128i superBlankFlag = _mm_and_si128(hitSuperBlank, _mm_set1_epi32(GAME_BATCH_SUPER_BLANK));
+    return _mm_or_si128(found, superBlankFlag);
+}
+
+#else
+
+/**
+ * One guess for GAME_BATCH_LANES games, used where SSE2 isn't available
+ *
+ * @param batch batch to update
+ * @param g index of the first game, a multiple of GAME_BATCH_LANES
+ * @param bits letter bit guessed by each game, 0 for games without a guess
+ * @param results GAME_BATCH_* flags of each game
+ */
+static void guessLanes(GameBatch *batch, int g, const uint32_t *bits, uint8_t *results) {
+    for (int lane = 0; lane < GAME_BATCH_LANES; lane++) {
+        int i = g + lane;
+        uint32_t bit = bits[lane];
+        results[lane] = 0;
+        if (!bit) continue;
+
+        bool found = (batch->wordMask[i] & bit) != 0;
+        if (batch->superBlankMask[i] & bit) results[lane] |= GAME_BATCH_SUPER_BLANK;
+        batch->hiddenMask[i] &= ~bit;
+        batch->superBlankMask[i] &= ~bit;
+        batch->guessedMask[i] |= bit;
+        batch->versionDelta[i]++;
+
+        if (found) {
+            results[lane] |= GAME_BATCH_FOUND;
+        } else if (batch->shield[i]) {
+            batch->shield[i] = 0;
+        } else {
+            batch->lives[i]--;
+        }
+    }
+}
+
+#endif
+
+/**
+ * Applies one guess to every game of the batch, game by game the result is the same as calling processGuess.
+ * Guesses are expected to have passed validateGuess, anything that isn't a letter is skipped
+ *
+ * @param batch batch to update
+ * @param guesses one character per game, 0 to leave the game untouched
+ * @param results one byte per game, GAME_BATCH_FOUND and GAME_BATCH_SUPER_BLANK like processGuess's return value
+ */
+void processGuessBatch(GameBatch *batch, const char *guesses, uint8_t *results) {
+    for (int g = 0; g < batch->count; g += GAME_BATCH_LANES) {
+        uint32_t bits[GAME_BATCH_LANES];
+        int lanes = batch->count - g < GAME_BATCH_LANES ? batch->count - g : GAME_BATCH_LANES;
+        for (int lane = 0; lane < GAME_BATCH_LANES; lane++) {
+            bits[lane] = lane < lanes ? letterBit(guesses[g + lane]) : 0;
+        }
+
+        uint8_t laneResults[GAME_BATCH_LANES];
+#ifdef GAME_BATCH_SSE2
+        __m128i flags = guessLanes(batch, g, _mm_loadu_si128((const __m128i *) bits));
+        flags = _mm_packs_epi32(flags, flags);
+        flags = _mm_packus_epi16(flags, flags);
+        uint32_t packed = (uint32_t) _mm_cvtsi128_si32(flags);
+        memcpy(laneResults, &packed, sizeof(laneResults));
+#else
+        guessLanes(batch, g, bits, laneResults);
+#endif
+        memcpy(&results[g], laneResults, lanes);
+    }
+}
+
+/**
+ * Checks if a game of the batch is won, like isGameWon
+ *
+ * @param batch batch to look in
+ * @param index game index
+ * @return true if no blank is left
+ */
+bool gameBatchIsWon(const GameBatch *batch, int index) {
+    return batch->hiddenMask[index] == 0;
+}
+
+/**
+ * Checks if a game of the batch is over, like isGameOver
+ *
+ * @param batch batch to look in
+ * @param index game index
+ * @return true if the game is won or out of lives
+ */
+bool gameBatchIsOver(const GameBatch *batch, int index) {
+    return gameBatchIsWon(batch, index) || batch->lives[index] <= 0;
+}
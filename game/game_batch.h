@@ -0,0 +1,51 @@
+#ifndef GAME_BATCH_H
+#define GAME_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hangman.h"
+
+// lanes processed together by processGuessBatch, arrays are padded to a multiple of this
+#define GAME_BATCH_LANES 4
+
+// set in the results of processGuessBatch
+#define GAME_BATCH_FOUND 1
+#define GAME_BATCH_SUPER_BLANK 2
+
+// bit 26 of a hidden mask stands for blanks that no letter guess can reveal (digits, dashes, accents)
+#define GAME_BATCH_OTHER_BIT (1u << 26)
+
+/*
+ * Structure of arrays view of many games, one bit per letter 'a'..'z'. Games are copied in with gameBatchLoad,
+ * guessed with processGuessBatch and written back with gameBatchStore
+ */
+typedef struct {
+    int count;
+    int capacity;
+    uint32_t *wordMask;        // letters the word contains
+    uint32_t *hiddenMask;      // letters that still have a blank, plus GAME_BATCH_OTHER_BIT
+    uint32_t *loadedHidden;    // hiddenMask at load time, tells gameBatchStore what to reveal
+    uint32_t *guessedMask;     // letters guessed so far
+    uint32_t *superBlankMask;  // letter under the super blank, 0 once it was used
+    int32_t *lives;
+    uint32_t *shield;          // 1 while a shield is active
+    uint32_t *versionDelta;    // guesses processed since load
+} GameBatch;
+
+bool gameBatchInit(GameBatch *batch, int capacity);
+
+void gameBatchDestroy(GameBatch *batch);
+
+bool gameBatchLoad(GameBatch *batch, const GameState *games, int count);
+
+void gameBatchStore(const GameBatch *batch, GameState *games);
+
+// guesses[i] is the letter for game i, 0 skips the game; results[i] gets GAME_BATCH_* flags
+void processGuessBatch(GameBatch *batch, const char *guesses, uint8_t *results);
+
+bool gameBatchIsWon(const GameBatch *batch, int index);
+
+bool gameBatchIsOver(const GameBatch *batch, int index);
+
+#endif
@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "game_pool.h"
+
+/**
+ * Allocates every slot of the pool at once, nothing is allocated after this
+ *
+ * @param pool pool to initialise
+ * @param capacity maximum number of games alive at the same time
+ * @return false if memory ran out
+ */
+bool gamePoolInit(GamePool *pool, int capacity) {
+    memset(pool, 0, sizeof(GamePool));
+    pool->freeHead = -1;
+    if (capacity <= 0) return false;
+
+    pool->games = calloc(capacity, sizeof(GameState));
+    pool->nextFree = malloc(capacity * sizeof(int));
+    pool->inUse = calloc(capacity, sizeof(bool));
+    if (!pool->games || !pool->nextFree || !pool->inUse) {
+        gamePoolDestroy(pool);
+        return false;
+    }
+
+    // linked in ascending order so slots are handed out front to back
+    for (int i = 0; i < capacity; i++) {
+        pool->nextFree[i] = i + 1 < capacity ? i + 1 : -1;
+    }
+    pool->freeHead = 0;
+    pool->capacity = capacity;
+    return true;
+}
+
+/**
+ * Frees the memory of the pool, games taken from it become invalid
+ *
+ * @param pool pool to destroy
+ */
+void gamePoolDestroy(GamePool *pool) {
+    free(pool->games);
+    free(pool->nextFree);
+    free(pool->inUse);
+    memset(pool, 0, sizeof(GamePool));
+    pool->freeHead = -1;
+}
+
+/**
+ * Takes an unused game from the pool, the caller initialises it with initHangmanInPlace
+ *
+ * @param pool pool to take from
+ * @return the game, NULL if the pool is exhausted
+ */
+GameState *gamePoolAcquire(GamePool *pool) {
+    int index = pool->freeHead;
+    if (index < 0) return NULL;
+
+    pool->freeHead = pool->nextFree[index];
+    pool->nextFree[index] = -1;
+    pool->inUse[index] = true;
+    pool->liveCount++;
+    return &pool->games[index];
+}
+
+/**
+ * Puts a game back into the pool
+ *
+ * @param pool pool the game was taken from
+ * @param game game to release, ignored if it is not a live game of this pool
+ */
+void gamePoolRelease(GamePool *pool, GameState *game) {
+    int index = gamePoolIndexOf(pool, game);
+    if (index < 0 || !pool->inUse[index]) return;
+
+    pool->inUse[index] = false;
+    pool->nextFree[index] = pool->freeHead;
+    pool->freeHead = index;
+    pool->liveCount--;
+}
+
+/**
+ * Finds the slot a game occupies
+ *
+ * @param pool pool to look in
+ * @param game game to find
+ * @return slot index, -1 if the game is not part of the pool
+ */
+int gamePoolIndexOf(const GamePool *pool, const GameState *game) {
+    if (!pool->games || game < pool->games || game >= pool->games + pool->capacity) return -1;
+    return (int) (game - pool->games);
+}
@@ -0,0 +1,32 @@
+#ifndef GAME_POOL_H
+#define GAME_POOL_H
+
+#include <stdbool.h>
+
+#include "hangman.h"
+
+// fixed-size pool of game sessions, every GameState is allocated once up front and reused across rounds.
+// Only the batch bench uses it: the client plays a single game in place and the server keeps its games in the
+// per shard SessionPool, whose slots also carry the connection and session id
+typedef struct {
+    GameState *games;  // contiguous, so batch code can walk every slot in order
+    int *nextFree;     // free list links, -1 ends the list
+    bool *inUse;
+    int capacity;
+    int freeHead;
+    int liveCount;
+} GamePool;
+
+bool gamePoolInit(GamePool *pool, int capacity);
+
+void gamePoolDestroy(GamePool *pool);
+
+// returns an unused slot, NULL if every slot is taken
+GameState *gamePoolAcquire(GamePool *pool);
+
+void gamePoolRelease(GamePool *pool, GameState *game);
+
+// slot index of a game from this pool, -1 if it doesn't belong to it
+int gamePoolIndexOf(const GamePool *pool, const GameState *game);
+
+#endif
@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game_snapshot.h"
+
+// record layout, all integers are LEB128 varints:
+//   word id | guessed letter bitmask | flags byte | zigzag lives | [super blank pos] | [revealed position bitmask]
+// the revealed bitmask is only stored when power-ups revealed letters that were never guessed
+// file layout: magic | corpus fingerprint, 4 bytes little endian | varint game count | records
+#define FLAG_SHIELD 0x01
+#define FLAG_SUPER_BLANK 0x02
+#define FLAG_REVEALED_MASK 0x04
+
+static const uint8_t fileMagic[4] = {'H', 'G', 'S', '2'};
+#define FILE_HEADER_BYTES 8
+
+static size_t putVarint(uint8_t *buffer, size_t pos, size_t capacity, uint32_t value) {
+    do {
+        if (pos >= capacity) return 0;
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buffer[pos++] = byte | (value ? 0x80 : 0);
+    } while (value);
+    return pos;
+}
+
+static size_t getVarint(const uint8_t *buffer, size_t pos, size_t length, uint32_t *value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= length) return 0;
+        uint8_t byte = buffer[pos++];
+        result |= (uint32_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return pos;
+        }
+    }
+    return 0;
+}
+
+static uint32_t zigzag(int value) {
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+static int unzigzag(uint32_t value) {
+    return (int) (value >> 1) ^ -(int) (value & 1);
+}
+
+static bool letterInMask(uint32_t mask, char c) {
+    return c >= 'a' && c <= 'z' && (mask & (1u << (c - 'a')));
+}
+
+//the id a game carries is only trusted while it still names its word, a reloaded corpus may have moved it
+static bool sameWord(const WordCorpus *corpus, const GameState *game) {
+    const char *word = wordCorpusGetWord(corpus, game->wordId);
+    if (!word || strcmp(word, game->word) != 0) return false;
+    int category = wordCorpusGetCategoryOfWord(corpus, game->wordId);
+    return category >= 0 && strcmp(corpus->categories[category].name, game->wordFile) == 0;
+}
+
+/**
+ * Encodes a game into a compact binary record. The word is stored as its id in the corpus, session files
+ * carry the corpus fingerprint so ids are never read back against other word lists
+ *
+ * @param game game to encode
+ * @param corpus corpus the game's word was picked from
+ * @param buffer output buffer, GAME_SNAPSHOT_MAX_BYTES is always enough
+ * @param capacity size of the output buffer
+ * @return number of bytes written, 0 if the word is not in the corpus or the buffer is too small
+ */
+size_t gameSnapshotEncode(const GameState *game, const WordCorpus *corpus, uint8_t *buffer, size_t capacity) {
+    int wordId = sameWord(corpus, game) ? game->wordId : wordCorpusFindWord(corpus, game->wordFile, game->word);
+    if (wordId < 0) return 0;
+
+    uint32_t guessedMask = 0;
+    for (int i = 0; i < game->numGuessed; i++) {
+        char c = game->guessed[i];
+        if (c >= 'a' && c <= 'z') guessedMask |= 1u << (c - 'a');
+    }
+
+    // only store revealed positions if they can't be derived from the guesses
+    int len = strlen(game->word);
+    uint8_t revealedMask[MAX_WORD_LEN / 8] = {0};
+    bool needsMask = false;
+    for (int i = 0; i < len; i++) {
+        char c = game->word[i];
+        if (c == ' ') continue;
+        bool revealed = game->revealed[i] == c;
+        if (revealed) revealedMask[i / 8] |= 1 << (i % 8);
+        if (revealed != letterInMask(guessedMask, c)) needsMask = true;
+    }
+
+    uint8_t flags = 0;
+    if (game->shieldActive) flags |= FLAG_SHIELD;
+    if (game->superBlankPos >= 0) flags |= FLAG_SUPER_BLANK;
+    if (needsMask) flags |= FLAG_REVEALED_MASK;
+
+    size_t pos = 0;
+    if (!(pos = putVarint(buffer, pos, capacity, (uint32_t) wordId))) return 0;
+    if (!(pos = putVarint(buffer, pos, capacity, guessedMask))) return 0;
+    if (!(pos = putVarint(buffer, pos, capacity, flags))) return 0;
+    if (!(pos = putVarint(buffer, pos, capacity, zigzag(game->lives)))) return 0;
+    if (flags & FLAG_SUPER_BLANK) {
+        if (!(pos = putVarint(buffer, pos, capacity, (uint32_t) game->superBlankPos))) return 0;
+    }
+    if (flags & FLAG_REVEALED_MASK) {
+        size_t maskBytes = (len + 7) / 8;
+        if (pos + maskBytes > capacity) return 0;
+        memcpy(buffer + pos, revealedMask, maskBytes);
+        pos += maskBytes;
+    }
+    return pos;
+}
+
+/**
+ * Rebuilds a game from a record written by gameSnapshotEncode. Guessed letters come back in alphabetical order
+ *
+ * @param game game to fill
+ * @param corpus the same corpus the record was encoded with
+ * @param buffer encoded record
+ * @param length number of bytes available in buffer
+ * @return number of bytes consumed, 0 if the record is invalid
+ */
+size_t gameSnapshotDecode(GameState *game, const WordCorpus *corpus, const uint8_t *buffer, size_t length) {
+    uint32_t wordId, guessedMask, flags, lives, superBlankPos = 0;
+    size_t pos = 0;
+
+    if (!(pos = getVarint(buffer, pos, length, &wordId))) return 0;
+    if (!(pos = getVarint(buffer, pos, length, &guessedMask))) return 0;
+    if (!(pos = getVarint(buffer, pos, length, &flags))) return 0;
+    if (!(pos = getVarint(buffer, pos, length, &lives))) return 0;
+    if (flags & FLAG_SUPER_BLANK) {
+        if (!(pos = getVarint(buffer, pos, length, &superBlankPos))) return 0;
+    }
+
+    const char *word = wordCorpusGetWord(corpus, (int) wordId);
+    int category = wordCorpusGetCategoryOfWord(corpus, (int) wordId);
+    if (!word || category < 0) return 0;
+
+    int len = strlen(word);
+    if ((flags & FLAG_SUPER_BLANK) && superBlankPos >= (uint32_t) len) return 0;
+
+    const uint8_t *revealedMask = NULL;
+    if (flags & FLAG_REVEALED_MASK) {
+        size_t maskBytes = (len + 7) / 8;
+        if (pos + maskBytes > length) return 0;
+        revealedMask = buffer + pos;
+        pos += maskBytes;
+    }
+
+    memset(game, 0, sizeof(GameState));
+    snprintf(game->wordFile, MAX_WORD_LEN, "%s", corpus->categories[category].name);
+    snprintf(game->word, MAX_WORD_LEN, "%s", word);
+
+    for (int i = 0; i < len; i++) {
+        char c = word[i];
+        bool revealed = revealedMask ? (revealedMask[i / 8] >> (i % 8)) & 1 : letterInMask(guessedMask, c);
+        if (c == ' ') game->revealed[i] = ' ';
+        else if (revealed) game->revealed[i] = c;
+        else if ((flags & FLAG_SUPER_BLANK) && (uint32_t) i == superBlankPos) game->revealed[i] = '~';
+        else game->revealed[i] = '_';
+    }
+    game->revealed[len] = '\0';
+
+    for (int i = 0; i < 26; i++) {
+        if (guessedMask & (1u << i)) game->guessed[game->numGuessed++] = (char) ('a' + i);
+    }
+    game->guessed[game->numGuessed] = '\0';
+
+    game->lives = unzigzag(lives);
+    game->shieldActive = (flags & FLAG_SHIELD) ? 1 : 0;
+    game->superBlankPos = (flags & FLAG_SUPER_BLANK) ? (int) superBlankPos : -1;
+    game->wordId = (int) wordId;
+    game->version = 0;
+
+    return pos;
+}
+
+/**
+ * Writes games to a session file. The file is written next to the target and renamed over it,
+ * so a crash mid write never leaves a half written session behind
+ *
+ * @param path session file path
+ * @param corpus corpus the games' words come from
+ * @param games games to store
+ * @param count number of games
+ * @return true if every game was encoded and the file was written
+ */
+bool gameSnapshotSaveFile(const char *path, const WordCorpus *corpus, const GameState *games, int count) {
+    size_t capacity = FILE_HEADER_BYTES + 5 + (size_t) count * GAME_SNAPSHOT_MAX_BYTES;
+    uint8_t *buffer = malloc(capacity);
+    if (!buffer) return false;
+
+    // word ids are only meaningful with the exact corpus they were encoded with
+    memcpy(buffer, fileMagic, sizeof(fileMagic));
+    for (int i = 0; i < 4; i++) buffer[sizeof(fileMagic) + i] = (uint8_t) (corpus->fingerprint >> (8 * i));
+    size_t pos = putVarint(buffer, FILE_HEADER_BYTES, capacity, (uint32_t) count);
+    for (int i = 0; i < count && pos; i++) {
+        size_t written = gameSnapshotEncode(&games[i], corpus, buffer + pos, capacity - pos);
+        pos = written ? pos + written : 0;
+    }
+    if (!pos) {
+        free(buffer);
+        return false;
+    }
+
+    char tmpPath[512];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    FILE *file = fopen(tmpPath, "wb");
+    if (!file) {
+        free(buffer);
+        return false;
+    }
+    bool ok = fwrite(buffer, 1, pos, file) == pos;
+    ok = (fclose(file) == 0) && ok;
+    free(buffer);
+
+    if (ok) {
+        remove(path); // rename doesn't replace existing files on windows
+        ok = rename(tmpPath, path) == 0;
+    }
+    if (!ok) remove(tmpPath);
+    return ok;
+}
+
+/**
+ * Reads games back from a session file written by gameSnapshotSaveFile
+ *
+ * @param path session file path
+ * @param corpus corpus the games' words come from
+ * @param games output array
+ * @param maxCount capacity of the output array
+ * @return number of games restored, -1 if the file is missing, corrupt or was saved with other word lists
+ */
+int gameSnapshotLoadFile(const char *path, const WordCorpus *corpus, GameState *games, int maxCount) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return -1;
+
+    fseek(file, 0, SEEK_END);
+    long len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (len < FILE_HEADER_BYTES) {
+        fclose(file);
+        return -1;
+    }
+
+    uint8_t *buffer = malloc(len);
+    if (!buffer) {
+        fclose(file);
+        return -1;
+    }
+    size_t length = fread(buffer, 1, len, file);
+    fclose(file);
+
+    uint32_t count;
+    size_t pos = 0;
+    if (length < FILE_HEADER_BYTES || memcmp(buffer, fileMagic, sizeof(fileMagic)) != 0 ||
+        !(pos = getVarint(buffer, FILE_HEADER_BYTES, length, &count))) {
+        free(buffer);
+        return -1;
+    }
+
+    const uint8_t *stored = buffer + sizeof(fileMagic);
+    uint32_t fingerprint = (uint32_t) stored[0] | (uint32_t) stored[1] << 8 | (uint32_t) stored[2] << 16 |
+                           (uint32_t) stored[3] << 24;
+    if (fingerprint != corpus->fingerprint) {
+        printf("[WARNING] %s was saved with other word lists, ignoring it\n", path);
+        free(buffer);
+        return -1;
+    }
+
+    int restored = 0;
+    while ((uint32_t) restored < count && restored < maxCount) {
+        size_t consumed = gameSnapshotDecode(&games[restored], corpus, buffer + pos, length - pos);
+        if (!consumed) {
+            free(buffer);
+            return -1;
+        }
+        pos += consumed;
+        restored++;
+    }
+
+    free(buffer);
+    return restored;
+}
@@ -0,0 +1,22 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hangman.h"
+#include "word_corpus.h"
+
+// worst case size of one encoded game
+#define GAME_SNAPSHOT_MAX_BYTES 48
+
+size_t gameSnapshotEncode(const GameState *game, const WordCorpus *corpus, uint8_t *buffer, size_t capacity);
+
+size_t gameSnapshotDecode(GameState *game, const WordCorpus *corpus, const uint8_t *buffer, size_t length);
+
+bool gameSnapshotSaveFile(const char *path, const WordCorpus *corpus, const GameState *games, int count);
+
+int gameSnapshotLoadFile(const char *path, const WordCorpus *corpus, GameState *games, int maxCount);
+
+#endif
@@ -16,42 +16,82 @@
  */
 GameState initHangman(const char *wordFile, const char *word, int lives) {
     GameState game;
+    initHangmanInPlace(&game, wordFile, word, lives);
+    return game;
+}
+
+/**
+ * Returns rand(), for callers that share the global generator
+ *
+ * @param state unused
+ * @return a number between 0 and RAND_MAX
+ */
+int hangmanRand(void *state) {
+    (void) state;
+    return rand();
+}
+
+/**
+ * Intializes an existing GameState, used by pools and the ui so the whole struct isn't copied on every new round
+ *
+ * @param game GameState struct to overwrite
+ * @param wordFile pointer to the string containing name of the file
+ * @param word pointer to the string containing the word from the file
+ * @param lives amount of the initial lives of user when the game start
+ */
+void initHangmanInPlace(GameState *game, const char *wordFile, const char *word, int lives) {
+    initHangmanInPlaceWith(game, wordFile, word, lives, hangmanRand, NULL);
+}
 
-    strncpy(game.wordFile, wordFile, MAX_WORD_LEN);
+/**
+ * Intializes an existing GameState, drawing the super blank from the given generator instead of rand()
+ *
+ * @param game GameState struct to overwrite
+ * @param wordFile pointer to the string containing name of the file
+ * @param word pointer to the string containing the word from the file
+ * @param lives amount of the initial lives of user when the game start
+ * @param rng random number source, threads must not share one
+ * @param rngState passed to rng
+ */
+void initHangmanInPlaceWith(GameState *game, const char *wordFile, const char *word, int lives, HangmanRng rng,
+                            void *rngState) {
+    strncpy(game->wordFile, wordFile, MAX_WORD_LEN - 1);
+    game->wordFile[MAX_WORD_LEN - 1] = '\0';
 
-    strncpy(game.word, word, MAX_WORD_LEN);
-    stringToLower(game.word);
+    strncpy(game->word, word, MAX_WORD_LEN - 1);
+    game->word[MAX_WORD_LEN - 1] = '\0';
+    stringToLower(game->word);
 
-    copyStringToUnderscores(game.revealed, game.word);
+    copyStringToUnderscores(game->revealed, game->word);
 
-    for (int i = 0; game.word[i] != '\0'; i++) {
-        if (game.word[i] == ' ')
-            game.revealed[i] = ' ';
+    for (int i = 0; game->word[i] != '\0'; i++) {
+        if (game->word[i] == ' ')
+            game->revealed[i] = ' ';
     }
 
     // makes random blank a super blank
-    int len = strlen(game.word);
+    int len = strlen(game->word);
     int underscoreIndexes[MAX_WORD_LEN];
     int count = 0;
     for (int i = 0; i < len; i++) {
-        if (game.revealed[i] == '_')
+        if (game->revealed[i] == '_')
             underscoreIndexes[count++] = i;
     }
 
     if (count > 0)
-        game.superBlankPos = underscoreIndexes[rand() % count];
+        game->superBlankPos = underscoreIndexes[rng(rngState) % count];
     else
-        game.superBlankPos = -1;
+        game->superBlankPos = -1;
 
-    if (game.superBlankPos != -1)
-        game.revealed[game.superBlankPos] = '~';
+    if (game->superBlankPos != -1)
+        game->revealed[game->superBlankPos] = '~';
 
-    resetString(game.guessed);
-    game.numGuessed = 0;
-    game.lives = lives;
-    game.shieldActive = 0;
-
-    return game;
+    resetString(game->guessed);
+    game->numGuessed = 0;
+    game->lives = lives;
+    game->shieldActive = 0;
+    game->wordId = -1;
+    game->version = 0;
 }
 
 /**
@@ -82,6 +122,7 @@ bool validateGuess(const GameState *game, char guess) {
  */
 bool processGuess(GameState *game, char guess) {
     guess = tolower(guess);
+    game->version++;
 
     bool found = stringHasChar(game->word, guess);
 
@@ -167,13 +208,14 @@ GameState resetGame(const char *wordFile, const char *word, int lives) {
     return initHangman(wordFile, word, lives);
 }
 
-/**
- * This process the powers the player received from randomly choosing a box from power menu
- *
- * @param game GameState struct that contains the current state of the game
- * @param power_id id of the power up obtained
- */
-void activatePowerUp(GameState *game, int power_id) {
+// adds one line to a power up message, silently cut off when the buffer is full
+static void appendLine(char *message, size_t size, const char *line) {
+    size_t used = strlen(message);
+    if (used < size) snprintf(message + used, size - used, "%s\n", line);
+}
+
+// applies one power up and appends what the player is told, the bonus box applies a second one after its line
+static void applyPower(GameState *game, int power_id, HangmanRng rng, void *rngState, char *message, size_t size) {
     switch (power_id) {
         case 1: {
             // reveals random blank
@@ -187,16 +229,16 @@ void activatePowerUp(GameState *game, int power_id) {
             }
 
             if (count > 0) {
-                int idx = validIndexes[rand() % count];
+                int idx = validIndexes[rng(rngState) % count];
                 game->revealed[idx] = game->word[idx];
-                printf("Power-Up: A random letter was revealed!\n");
+                appendLine(message, size, "Power-Up: A random letter was revealed!");
             }
         }
         break;
 
         case 2: // gives extra life
             game->lives++;
-            printf("Power-Up: +1 Life!\n");
+            appendLine(message, size, "Power-Up: +1 Life!");
             break;
 
         case 3: // shows all vowels
@@ -205,32 +247,60 @@ void activatePowerUp(GameState *game, int power_id) {
                 if (c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u')
                     game->revealed[i] = c;
             }
-            printf("Power-Up: All vowels revealed!\n");
+            appendLine(message, size, "Power-Up: All vowels revealed!");
             break;
 
         case 4: // activates shield
             game->shieldActive = 1;
-            printf("Power-Up: Shield activated!\n");
+            appendLine(message, size, "Power-Up: Shield activated!");
             break;
 
         case 5: {
             // funny chance power
-            int roll = rand() % 100 + 1;
+            int roll = rng(rngState) % 100 + 1;
 
             if (roll <= 5) {
-                printf("Bonus random power up!\n");
-                activatePowerUp(game, rand() % 4 + 1);
+                appendLine(message, size, "Bonus random power up!");
+                applyPower(game, rng(rngState) % 4 + 1, rng, rngState, message, size);
             } else if (roll <= 10) {
                 game->lives--;
-                printf("Lost 1 life.\n");
+                appendLine(message, size, "Lost 1 life.");
             } else {
-                printf("Nothing happened.\n");
+                appendLine(message, size, "Nothing happened.");
             }
         }
         break;
     }
 }
 
+/**
+ * Applies a power up without printing anything, used by frontends that show the result themselves
+ *
+ * @param game GameState struct that contains the current state of the game
+ * @param power_id id of the power up obtained
+ * @param rng random number source, threads must not share one
+ * @param rngState passed to rng
+ * @param message filled with what the player is told, one line each ending in a newline, empty if nothing is said
+ * @param size size of message, at least 1
+ */
+void applyPowerUp(GameState *game, int power_id, HangmanRng rng, void *rngState, char *message, size_t size) {
+    message[0] = '\0';
+    game->version++;
+    applyPower(game, power_id, rng, rngState, message, size);
+}
+
+/**
+ * This process the powers the player received from randomly choosing a box from power menu
+ *
+ * @param game GameState struct that contains the current state of the game
+ * @param power_id id of the power up obtained
+ */
+void activatePowerUp(GameState *game, int power_id) {
+    char message[256];
+    applyPowerUp(game, power_id, hangmanRand, NULL, message, sizeof(message));
+    printf("%s", message);
+}
+
 /**
  * Shows user the power up menu to pick a random box, calls activatePowerUp() to activate that power up
  * Fills 3 random boxes out of 9 with random power ups
@@ -2,6 +2,7 @@
 #define HANGMAN_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #define MAX_WORD_LEN 128
 #define MAX_GUESSED 64
@@ -15,12 +16,24 @@ typedef struct {
     int lives;
     int shieldActive;
     int superBlankPos;
+    int wordId; //id of the word in the corpus it was picked from, -1 if it came from a word file
+    unsigned int version; //bumped on every state change, lets the ui know when to rebuild cached text
 } GameState;
 
+// source of random numbers, returns a non negative int like rand(). The server gives every shard its own
+typedef int (*HangmanRng)(void *state);
+
+// rand() as a HangmanRng, used by the CLI and the game window
+int hangmanRand(void *state);
 
 // hangman
 GameState initHangman(const char *wordFile, const char *word, int lives);
 
+void initHangmanInPlace(GameState *game, const char *wordFile, const char *word, int lives);
+
+void initHangmanInPlaceWith(GameState *game, const char *wordFile, const char *word, int lives, HangmanRng rng,
+                            void *rngState);
+
 bool processGuess(GameState *game, char guess);
 
 bool validateGuess(const GameState *game, char guess);
@@ -42,4 +55,6 @@ void powerUpMenu(GameState *game);
 
 void activatePowerUp(GameState *game, int power_id);
 
+void applyPowerUp(GameState *game, int power_id, HangmanRng rng, void *rngState, char *message, size_t size);
+
 #endif
@@ -0,0 +1,374 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "word_corpus.h"
+#include "hangman.h"
+
+/**
+ * Reads a whole file into a NUL terminated heap buffer
+ *
+ * @param path path of the file
+ * @param outLen set to the number of bytes read
+ * @return buffer that the caller frees, NULL if the file could not be read
+ */
+static char *readWholeFile(const char *path, long *outLen) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (len < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char *buffer = malloc(len + 1);
+    if (!buffer) {
+        fclose(file);
+        return NULL;
+    }
+    len = (long) fread(buffer, 1, len, file);
+    buffer[len] = '\0';
+    fclose(file);
+
+    *outLen = len;
+    return buffer;
+}
+
+/**
+ * Makes sure the corpus arrays can hold the given amount of text and words
+ *
+ * @return false if memory ran out
+ */
+static bool reserve(WordCorpus *corpus, long *textCap, long textNeeded, int *wordCap, int wordsNeeded) {
+    if (textNeeded > *textCap) {
+        long newCap = *textCap ? *textCap : 4096;
+        while (newCap < textNeeded) newCap *= 2;
+        char *text = realloc(corpus->text, newCap);
+        if (!text) return false;
+        corpus->text = text;
+        *textCap = newCap;
+    }
+    if (wordsNeeded > *wordCap) {
+        int newCap = *wordCap ? *wordCap : 256;
+        while (newCap < wordsNeeded) newCap *= 2;
+        int *offsets = realloc(corpus->wordOffsets, newCap * sizeof(int));
+        if (!offsets) return false;
+        corpus->wordOffsets = offsets;
+        *wordCap = newCap;
+    }
+    return true;
+}
+
+typedef struct {
+    uint16_t score;
+    int wordId;
+} RankedWord;
+
+static int compareRankedWords(const void *a, const void *b) {
+    const RankedWord *x = a, *y = b;
+    if (x->score != y->score) return x->score < y->score ? -1 : 1;
+    return x->wordId - y->wordId;
+}
+
+/**
+ * Fills in the difficulty of every word and sorts each category into easy, medium and hard thirds.
+ * Scores come from the <category>.difficulty file written by hangman_wordprep when it matches the list,
+ * otherwise the category is ranked by letter rarity, which only looks at each word once. The solver is left
+ * to hangman_wordprep so loads and hot reloads stay linear in the size of the list
+ *
+ * @param corpus corpus whose words are all loaded
+ * @param directory folder the word files came from
+ * @return false if memory ran out
+ */
+static bool buildDifficultyIndex(WordCorpus *corpus, const char *directory) {
+    corpus->difficulty = calloc(corpus->wordCount, sizeof(WordDifficulty));
+    corpus->difficultyOrder = malloc(corpus->wordCount * sizeof(int));
+    const char **words = malloc(corpus->wordCount * sizeof(char *));
+    RankedWord *ranked = malloc(corpus->wordCount * sizeof(RankedWord));
+    if (!corpus->difficulty || !corpus->difficultyOrder || !words || !ranked) {
+        free(words);
+        free(ranked);
+        return false;
+    }
+
+    for (int i = 0; i < corpus->wordCount; i++) {
+        words[i] = wordCorpusGetWord(corpus, i);
+    }
+
+    for (int c = 0; c < corpus->categoryCount; c++) {
+        WordCategory *category = &corpus->categories[c];
+        const char *const *categoryWords = words + category->firstWord;
+        WordDifficulty *difficulty = corpus->difficulty + category->firstWord;
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.difficulty", directory, category->name);
+        uint32_t hash = wordDifficultyHashWords(categoryWords, category->wordCount);
+        if (!wordDifficultyLoad(path, hash, difficulty, category->wordCount)) {
+            wordDifficultyMeasure(categoryWords, category->wordCount, difficulty);
+        }
+
+        for (int i = 0; i < category->wordCount; i++) {
+            ranked[i].score = difficulty[i].score;
+            ranked[i].wordId = category->firstWord + i;
+        }
+        qsort(ranked, category->wordCount, sizeof(RankedWord), compareRankedWords);
+        for (int i = 0; i < category->wordCount; i++) {
+            corpus->difficultyOrder[category->firstWord + i] = ranked[i].wordId;
+        }
+
+        // thirds by rank, so every band has words even when many share a score
+        for (int b = 0; b <= DIFFICULTY_BANDS; b++) {
+            category->bandStart[b] = category->wordCount * b / DIFFICULTY_BANDS;
+        }
+    }
+
+    free(words);
+    free(ranked);
+    return true;
+}
+
+/**
+ * Fingerprints the layout of the corpus with FNV-1a over every category name, its word count and the text of
+ * all words. Two corpora with the same fingerprint give every word the same id
+ *
+ * @param corpus corpus whose words are all loaded
+ * @return hash of the corpus
+ */
+static uint32_t fingerprintCorpus(const WordCorpus *corpus) {
+    uint32_t hash = 2166136261u;
+    for (int c = 0; c < corpus->categoryCount; c++) {
+        const WordCategory *category = &corpus->categories[c];
+        const char *name = category->name;
+        do {
+            hash ^= (unsigned char) *name;
+            hash *= 16777619u;
+        } while (*name++);
+        for (int i = 0; i < 4; i++) {
+            hash ^= (uint8_t) ((uint32_t) category->wordCount >> (8 * i));
+            hash *= 16777619u;
+        }
+    }
+
+    // words are stored back to back with their terminators, so the text also covers every offset
+    const char *word = wordCorpusGetWord(corpus, corpus->wordCount - 1);
+    size_t textLen = (size_t) (word - corpus->text) + strlen(word) + 1;
+    for (size_t i = 0; i < textLen; i++) {
+        hash ^= (unsigned char) corpus->text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Loads every listed category file from the directory into one contiguous corpus.
+ * Words get consecutive ids in file order, category by category
+ *
+ * @param corpus corpus to fill, any previous content is not freed
+ * @param directory folder containing <category>.txt files
+ * @param categoryNames names of the categories to load
+ * @param categoryCount number of names in categoryNames
+ * @return true if at least one word was loaded
+ */
+bool wordCorpusLoad(WordCorpus *corpus, const char *directory, char **categoryNames, int categoryCount) {
+    memset(corpus, 0, sizeof(WordCorpus));
+
+    long textLen = 0, textCap = 0;
+    int wordCap = 0;
+
+    for (int c = 0; c < categoryCount && corpus->categoryCount < MAX_CATEGORIES; c++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.txt", directory, categoryNames[c]);
+
+        long fileLen;
+        char *data = readWholeFile(path, &fileLen);
+        if (!data) {
+            printf("[WARNING] Failed to read word file %s\n", path);
+            continue;
+        }
+
+        WordCategory *category = &corpus->categories[corpus->categoryCount];
+        snprintf(category->name, sizeof(category->name), "%s", categoryNames[c]);
+        category->firstWord = corpus->wordCount;
+        category->wordCount = 0;
+
+        char *line = data;
+        while (*line) {
+            size_t lineLen = strcspn(line, "\r\n");
+            char *next = line + lineLen;
+            while (*next == '\r' || *next == '\n') next++;
+
+            // words longer than the game can hold are skipped instead of cut off
+            if (lineLen > 0 && lineLen < MAX_WORD_LEN) {
+                if (!reserve(corpus, &textCap, textLen + (long) lineLen + 1, &wordCap, corpus->wordCount + 1)) {
+                    free(data);
+                    wordCorpusFree(corpus);
+                    return false;
+                }
+                corpus->wordOffsets[corpus->wordCount++] = (int) textLen;
+                for (size_t i = 0; i < lineLen; i++) {
+                    corpus->text[textLen++] = (char) tolower((unsigned char) line[i]);
+                }
+                corpus->text[textLen++] = '\0';
+                category->wordCount++;
+            }
+            line = next;
+        }
+        free(data);
+
+        if (category->wordCount > 0) corpus->categoryCount++;
+    }
+
+    if (corpus->wordCount == 0) return false;
+    if (!buildDifficultyIndex(corpus, directory)) {
+        wordCorpusFree(corpus);
+        return false;
+    }
+    corpus->fingerprint = fingerprintCorpus(corpus);
+    return true;
+}
+
+/**
+ * Frees all memory owned by the corpus and leaves it empty
+ *
+ * @param corpus corpus to free
+ */
+void wordCorpusFree(WordCorpus *corpus) {
+    free(corpus->text);
+    free(corpus->wordOffsets);
+    free(corpus->difficulty);
+    free(corpus->difficultyOrder);
+    memset(corpus, 0, sizeof(WordCorpus));
+}
+
+/**
+ * Returns the word with the given id
+ *
+ * @param corpus loaded corpus
+ * @param wordId id of the word
+ * @return lower cased word, NULL if the id is out of range
+ */
+const char *wordCorpusGetWord(const WordCorpus *corpus, int wordId) {
+    if (wordId < 0 || wordId >= corpus->wordCount) return NULL;
+    return corpus->text + corpus->wordOffsets[wordId];
+}
+
+/**
+ * Returns the index of the category the word belongs to
+ *
+ * @param corpus loaded corpus
+ * @param wordId id of the word
+ * @return index into corpus->categories, -1 if the id is out of range
+ */
+int wordCorpusGetCategoryOfWord(const WordCorpus *corpus, int wordId) {
+    for (int c = 0; c < corpus->categoryCount; c++) {
+        const WordCategory *category = &corpus->categories[c];
+        if (wordId >= category->firstWord && wordId < category->firstWord + category->wordCount) return c;
+    }
+    return -1;
+}
+
+/**
+ * Looks a category up by name
+ *
+ * @param corpus loaded corpus
+ * @param name category name (word file name without extension)
+ * @return index into corpus->categories, -1 if not found
+ */
+int wordCorpusFindCategory(const WordCorpus *corpus, const char *name) {
+    for (int c = 0; c < corpus->categoryCount; c++) {
+        if (strcmp(corpus->categories[c].name, name) == 0) return c;
+    }
+    return -1;
+}
+
+/**
+ * Finds the id of a word inside a category, ignoring case
+ *
+ * @param corpus loaded corpus
+ * @param category category name the word was picked from
+ * @param word the word to look for
+ * @return word id, -1 if the word is not part of the category
+ */
+int wordCorpusFindWord(const WordCorpus *corpus, const char *category, const char *word) {
+    int c = wordCorpusFindCategory(corpus, category);
+    if (c < 0) return -1;
+
+    const WordCategory *cat = &corpus->categories[c];
+    for (int id = cat->firstWord; id < cat->firstWord + cat->wordCount; id++) {
+        const char *candidate = corpus->text + corpus->wordOffsets[id];
+        int i = 0;
+        while (candidate[i] && candidate[i] == (char) tolower((unsigned char) word[i])) i++;
+        if (candidate[i] == '\0' && word[i] == '\0') return id;
+    }
+    return -1;
+}
+
+/**
+ * Starts a new game on a random word of a random category, the word is copied straight from the corpus so
+ * nothing is allocated
+ *
+ * @param corpus loaded corpus
+ * @param game GameState struct to initialise in place
+ * @param lives amount of the initial lives
+ * @return false if the corpus has no words
+ */
+bool wordCorpusStartRandomGame(const WordCorpus *corpus, GameState *game, int lives) {
+    if (corpus->categoryCount == 0 || corpus->wordCount == 0) return false;
+
+    // same odds as getRandomWordFileName + getRandomWordFromFile: uniform category, then uniform word
+    const WordCategory *category;
+    do {
+        category = &corpus->categories[rand() % corpus->categoryCount];
+    } while (category->wordCount == 0);
+
+    int wordId = category->firstWord + rand() % category->wordCount;
+    initHangmanInPlace(game, category->name, wordCorpusGetWord(corpus, wordId), lives);
+    game->wordId = wordId;
+    return true;
+}
+
+/**
+ * Returns the difficulty features of a word
+ *
+ * @param corpus loaded corpus
+ * @param wordId id of the word
+ * @return difficulty of the word, NULL if the id is out of range
+ */
+const WordDifficulty *wordCorpusGetDifficulty(const WordCorpus *corpus, int wordId) {
+    if (wordId < 0 || wordId >= corpus->wordCount || !corpus->difficulty) return NULL;
+    return &corpus->difficulty[wordId];
+}
+
+/**
+ * Picks a word of a difficulty band in constant time
+ *
+ * @param corpus loaded corpus
+ * @param category category to pick from, -1 for a random one
+ * @param band wanted difficulty, the whole category is used if it is too small to have words in this band
+ * @param random random number from the caller's generator, so threads can each use their own
+ * @return word id, -1 if there is nothing to pick from
+ */
+int wordCorpusPickByDifficulty(const WordCorpus *corpus, int category, DifficultyBand band, unsigned int random) {
+    if (corpus->categoryCount == 0 || !corpus->difficultyOrder || band < 0 || band >= DIFFICULTY_BANDS) return -1;
+
+    if (category < 0) {
+        category = (int) (random % (unsigned int) corpus->categoryCount);
+        random /= (unsigned int) corpus->categoryCount;
+    }
+    if (category >= corpus->categoryCount) return -1;
+
+    const WordCategory *cat = &corpus->categories[category];
+    int start = cat->bandStart[band];
+    int count = cat->bandStart[band + 1] - start;
+    if (count <= 0) {
+        start = 0;
+        count = cat->wordCount;
+    }
+    if (count <= 0) return -1;
+
+    return corpus->difficultyOrder[cat->firstWord + start + (int) (random % (unsigned int) count)];
+}
@@ -0,0 +1,51 @@
+#ifndef WORD_CORPUS_H
+#define WORD_CORPUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hangman.h"
+#include "word_difficulty.h"
+
+#define MAX_CATEGORIES 64
+#define MAX_CATEGORY_NAME 64
+
+typedef struct {
+    char name[MAX_CATEGORY_NAME];
+    int firstWord; // id of the first word of this category
+    int wordCount;
+    int bandStart[DIFFICULTY_BANDS + 1]; // where each band starts in this category's part of difficultyOrder
+} WordCategory;
+
+// every word of every category, lower cased, stored back to back in one buffer
+typedef struct {
+    char *text;
+    int *wordOffsets; // word id -> offset of its first character inside text
+    int wordCount;
+    WordDifficulty *difficulty; // word id -> difficulty features
+    int *difficultyOrder;       // word ids of every category from easiest to hardest, same layout as the ids
+    WordCategory categories[MAX_CATEGORIES];
+    int categoryCount;
+    uint32_t fingerprint; // FNV-1a of the categories and their words, changes whenever a word id would
+} WordCorpus;
+
+bool wordCorpusLoad(WordCorpus *corpus, const char *directory, char **categoryNames, int categoryCount);
+
+void wordCorpusFree(WordCorpus *corpus);
+
+const char *wordCorpusGetWord(const WordCorpus *corpus, int wordId);
+
+int wordCorpusGetCategoryOfWord(const WordCorpus *corpus, int wordId);
+
+int wordCorpusFindCategory(const WordCorpus *corpus, const char *name);
+
+int wordCorpusFindWord(const WordCorpus *corpus, const char *category, const char *word);
+
+bool wordCorpusStartRandomGame(const WordCorpus *corpus, GameState *game, int lives);
+
+const WordDifficulty *wordCorpusGetDifficulty(const WordCorpus *corpus, int wordId);
+
+// O(1) pick from a difficulty band, category -1 picks the category too; returns the word id or -1
+int wordCorpusPickByDifficulty(const WordCorpus *corpus, int category, DifficultyBand band, unsigned int random);
+
+#endif
@@ -0,0 +1,340 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "word_difficulty.h"
+
+#define DIFFICULTY_MAGIC "HWD1"
+#define DIFFICULTY_RECORD_BYTES 8
+
+// -log2 of how often each letter shows up in english text, rare letters carry more bits
+static const double letterSurprisal[26] = {
+    3.614, 6.067, 5.168, 4.555, 2.977, 5.488, 5.633, 4.036, 3.844, 9.352, 7.017, 4.635, 5.377,
+    3.889, 3.736, 5.696, 10.040, 4.062, 3.982, 3.465, 5.180, 6.676, 5.405, 9.381, 5.663, 10.400
+};
+
+static const char *bandNames[DIFFICULTY_BANDS] = {"easy", "medium", "hard"};
+
+static uint32_t letterBit(char ch) {
+    if (ch < 'a' || ch > 'z') return 0;
+    return 1u << (ch - 'a');
+}
+
+static uint32_t lettersOf(const char *word) {
+    uint32_t mask = 0;
+    for (int i = 0; word[i]; i++) mask |= letterBit(word[i]);
+    return mask;
+}
+
+// a word still in play, grouped with the others that showed the guessed letters in the same places
+typedef struct {
+    uint64_t pattern[2];    // positions of the last guessed letter, or of the spaces before the first guess
+    int length;
+    int word;
+} Candidate;
+
+typedef struct {
+    const char *const *words;
+    const uint32_t *letters;    // lettersOf every word
+    WordDifficulty *out;
+} SolveContext;
+
+static int compareCandidates(const void *a, const void *b) {
+    const Candidate *x = a, *y = b;
+    if (x->length != y->length) return x->length < y->length ? -1 : 1;
+    if (x->pattern[1] != y->pattern[1]) return x->pattern[1] < y->pattern[1] ? -1 : 1;
+    if (x->pattern[0] != y->pattern[0]) return x->pattern[0] < y->pattern[0] ? -1 : 1;
+    return x->word - y->word;
+}
+
+static void patternOf(const char *word, char letter, uint64_t pattern[2]) {
+    pattern[0] = pattern[1] = 0;
+    for (int i = 0; word[i] && i < 128; i++) {
+        if (word[i] == letter) pattern[i >> 6] |= 1ull << (i & 63);
+    }
+}
+
+/**
+ * Plays every word of a group at once with a solver that always guesses the letter found in most of the words
+ * still possible. All words of a group have seen the same guesses answered the same way, so they share the next
+ * guess and only get split by where that letter shows up. Each level narrows the group in place, which makes
+ * the whole list cost one sort per guess instead of one pass over the list per word and guess
+ *
+ * @param context words, their letters and where the results go
+ * @param group words that can't be told apart yet
+ * @param size number of words in the group
+ * @param guessed letters guessed so far
+ * @param lastGuess bit of the letter guessed last, 0 before the first guess
+ * @param guesses number of guesses so far
+ * @param misses wrong guesses among them
+ */
+static void solveGroup(const SolveContext *context, Candidate *group, int size, uint32_t guessed,
+                       uint32_t lastGuess, int guesses, int misses) {
+    // a word on its own is the only candidate left, every letter it still misses is a hit
+    if (size == 1) {
+        uint32_t letters = context->letters[group[0].word];
+        if (!(letters & ~guessed) && guesses > 0 && !(letters & lastGuess)) return;
+        int left = 0;
+        for (uint32_t missing = letters & ~guessed; missing; missing &= missing - 1) left++;
+        context->out[group[0].word].solverGuesses = (uint8_t) (guesses + left);
+        context->out[group[0].word].solverMisses = (uint8_t) misses;
+        return;
+    }
+
+    int counts[26] = {0};
+    bool open = false;
+    for (int c = 0; c < size; c++) {
+        uint32_t letters = context->letters[group[c].word];
+        uint32_t missing = letters & ~guessed;
+        if (!missing) {
+            // solved by this guess, words solved earlier only stay as candidates for the others
+            if (guesses == 0 || (letters & lastGuess)) {
+                context->out[group[c].word].solverGuesses = (uint8_t) guesses;
+                context->out[group[c].word].solverMisses = (uint8_t) misses;
+            }
+            continue;
+        }
+        open = true;
+        for (int l = 0; l < 26; l++) counts[l] += (missing >> l) & 1;
+    }
+    if (!open) return;
+
+    // most common letter among the candidates, english frequency breaks ties
+    int best = -1;
+    for (int l = 0; l < 26; l++) {
+        if (guessed & (1u << l)) continue;
+        if (best < 0 || counts[l] > counts[best] ||
+            (counts[l] == counts[best] && letterSurprisal[l] < letterSurprisal[best])) {
+            best = l;
+        }
+    }
+
+    for (int c = 0; c < size; c++) patternOf(context->words[group[c].word], (char) ('a' + best), group[c].pattern);
+    qsort(group, size, sizeof(Candidate), compareCandidates);
+
+    for (int first = 0; first < size;) {
+        int last = first + 1;
+        while (last < size && group[last].pattern[0] == group[first].pattern[0] &&
+               group[last].pattern[1] == group[first].pattern[1]) {
+            last++;
+        }
+        bool hit = group[first].pattern[0] || group[first].pattern[1];
+        solveGroup(context, group + first, last - first, guessed | 1u << best, 1u << best, guesses + 1,
+                   misses + !hit);
+        first = last;
+    }
+}
+
+/**
+ * Computes the features that only depend on the word itself. The score is the rarity alone
+ *
+ * @param word word to measure, lower case
+ * @param difficulty filled in, the solver fields are left at 0
+ */
+static void measureWord(const char *word, WordDifficulty *difficulty) {
+    memset(difficulty, 0, sizeof(WordDifficulty));
+
+    int length = 0;
+    for (int i = 0; word[i]; i++) length += letterBit(word[i]) != 0;
+    uint32_t letters = lettersOf(word);
+
+    double surprisal = 0;
+    int distinct = 0;
+    for (int l = 0; l < 26; l++) {
+        if (!(letters & (1u << l))) continue;
+        surprisal += letterSurprisal[l];
+        distinct++;
+    }
+
+    difficulty->length = (uint8_t) (length > 255 ? 255 : length);
+    difficulty->distinctLetters = (uint8_t) distinct;
+    difficulty->rarity = (uint16_t) (distinct ? surprisal / distinct * 16.0 + 0.5 : 0);
+    difficulty->score = difficulty->rarity;
+}
+
+/**
+ * Computes length, distinct letters and rarity of every word, linear in the size of the list
+ *
+ * @param words every word of the list, lower case
+ * @param count number of words
+ * @param out difficulty of every word
+ */
+void wordDifficultyMeasure(const char *const *words, int count, WordDifficulty *out) {
+    for (int w = 0; w < count; w++) measureWord(words[w], &out[w]);
+}
+
+/**
+ * Computes every difficulty feature including the solver's guesses and misses. Words only compete with words
+ * of the same length and spaces, and the solver narrows those groups guess by guess, so the cost is
+ * O(n log n) per guess and at most 26 guesses
+ *
+ * @param words every word of the list, lower case
+ * @param count number of words
+ * @param out difficulty of every word
+ * @return false if memory ran out, out then only holds the cheap features
+ */
+bool wordDifficultyScore(const char *const *words, int count, WordDifficulty *out) {
+    wordDifficultyMeasure(words, count, out);
+    if (count <= 0) return true;
+
+    Candidate *candidates = malloc(count * sizeof(Candidate));
+    uint32_t *letters = malloc(count * sizeof(uint32_t));
+    if (!candidates || !letters) {
+        free(candidates);
+        free(letters);
+        return false;
+    }
+
+    // the length and the spaces are visible from the start
+    for (int w = 0; w < count; w++) {
+        letters[w] = lettersOf(words[w]);
+        candidates[w].length = (int) strlen(words[w]);
+        candidates[w].word = w;
+        patternOf(words[w], ' ', candidates[w].pattern);
+    }
+    qsort(candidates, count, sizeof(Candidate), compareCandidates);
+
+    SolveContext context = {words, letters, out};
+    for (int first = 0; first < count;) {
+        int last = first + 1;
+        while (last < count && candidates[last].length == candidates[first].length &&
+               candidates[last].pattern[0] == candidates[first].pattern[0] &&
+               candidates[last].pattern[1] == candidates[first].pattern[1]) {
+            last++;
+        }
+        solveGroup(&context, candidates + first, last - first, 0, 0, 0, 0);
+        first = last;
+    }
+
+    for (int w = 0; w < count; w++) out[w].score = (uint16_t) (out[w].solverMisses * 256 + out[w].rarity);
+
+    free(candidates);
+    free(letters);
+    return true;
+}
+
+/**
+ * Fingerprints a word list with FNV-1a over every word and its terminator
+ *
+ * @param words words of the list
+ * @param count number of words
+ * @return hash of the list
+ */
+uint32_t wordDifficultyHashWords(const char *const *words, int count) {
+    uint32_t hash = 2166136261u;
+    for (int w = 0; w < count; w++) {
+        const char *p = words[w];
+        do {
+            hash ^= (unsigned char) *p;
+            hash *= 16777619u;
+        } while (*p++);
+    }
+    return hash;
+}
+
+static void putU32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (uint8_t) (value >> (8 * i));
+}
+
+static uint32_t getU32(const uint8_t *in) {
+    return (uint32_t) in[0] | (uint32_t) in[1] << 8 | (uint32_t) in[2] << 16 | (uint32_t) in[3] << 24;
+}
+
+/**
+ * Writes the difficulty of a word list next to it, through a temporary file so readers never see half of it
+ *
+ * @param path file to write
+ * @param hash wordDifficultyHashWords of the list
+ * @param difficulty one entry per word
+ * @param count number of words
+ * @return true if the file was written
+ */
+bool wordDifficultySave(const char *path, uint32_t hash, const WordDifficulty *difficulty, int count) {
+    char tmpPath[1024];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    FILE *file = fopen(tmpPath, "wb");
+    if (!file) return false;
+
+    uint8_t header[12];
+    memcpy(header, DIFFICULTY_MAGIC, 4);
+    putU32(header + 4, (uint32_t) count);
+    putU32(header + 8, hash);
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+    for (int i = 0; i < count && ok; i++) {
+        const WordDifficulty *d = &difficulty[i];
+        uint8_t record[DIFFICULTY_RECORD_BYTES] = {
+            d->length, d->distinctLetters, d->solverGuesses, d->solverMisses,
+            (uint8_t) d->rarity, (uint8_t) (d->rarity >> 8), (uint8_t) d->score, (uint8_t) (d->score >> 8)
+        };
+        ok = fwrite(record, 1, sizeof(record), file) == sizeof(record);
+    }
+
+    if (fclose(file) != 0) ok = false;
+    if (ok) {
+        remove(path);
+        ok = rename(tmpPath, path) == 0;
+    }
+    if (!ok) remove(tmpPath);
+    return ok;
+}
+
+/**
+ * Reads a saved difficulty index if it was computed from exactly this word list
+ *
+ * @param path file to read
+ * @param hash wordDifficultyHashWords of the list as it is now
+ * @param difficulty filled with one entry per word
+ * @param count number of words in the list
+ * @return false if the file is missing, damaged or belongs to another version of the list
+ */
+bool wordDifficultyLoad(const char *path, uint32_t hash, WordDifficulty *difficulty, int count) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t header[12];
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+              memcmp(header, DIFFICULTY_MAGIC, 4) == 0 && getU32(header + 4) == (uint32_t) count &&
+              getU32(header + 8) == hash;
+
+    for (int i = 0; i < count && ok; i++) {
+        uint8_t record[DIFFICULTY_RECORD_BYTES];
+        if (fread(record, 1, sizeof(record), file) != sizeof(record)) {
+            ok = false;
+            break;
+        }
+        WordDifficulty *d = &difficulty[i];
+        d->length = record[0];
+        d->distinctLetters = record[1];
+        d->solverGuesses = record[2];
+        d->solverMisses = record[3];
+        d->rarity = (uint16_t) (record[4] | record[5] << 8);
+        d->score = (uint16_t) (record[6] | record[7] << 8);
+    }
+
+    fclose(file);
+    return ok;
+}
+
+/**
+ * Returns the name of a band as used by the server protocol
+ *
+ * @param band difficulty band
+ * @return "easy", "medium" or "hard"
+ */
+const char *wordDifficultyBandName(DifficultyBand band) {
+    return band >= 0 && band < DIFFICULTY_BANDS ? bandNames[band] : "unknown";
+}
+
+/**
+ * Looks up a band by name
+ *
+ * @param name "easy", "medium" or "hard"
+ * @return the band, DIFFICULTY_BANDS if the name is unknown
+ */
+DifficultyBand wordDifficultyFindBand(const char *name) {
+    for (int b = 0; b < DIFFICULTY_BANDS; b++) {
+        if (strcmp(name, bandNames[b]) == 0) return (DifficultyBand) b;
+    }
+    return DIFFICULTY_BANDS;
+}
@@ -0,0 +1,42 @@
+#ifndef WORD_DIFFICULTY_H
+#define WORD_DIFFICULTY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    DIFFICULTY_EASY,
+    DIFFICULTY_MEDIUM,
+    DIFFICULTY_HARD,
+    DIFFICULTY_BANDS
+} DifficultyBand;
+
+typedef struct {
+    uint8_t length;          // letters only, spaces don't count
+    uint8_t distinctLetters;
+    uint8_t solverGuesses;   // guesses a letter frequency solver needs to reveal the word
+    uint8_t solverMisses;    // wrong guesses among them, these are what cost lives
+    uint16_t rarity;         // average surprisal of the distinct letters in english text, in 1/16 bits
+    uint16_t score;          // higher is harder, solver misses first and rarity to break ties, or rarity alone
+} WordDifficulty;
+
+// length, distinct letters and rarity only, cheap enough to run on every load
+void wordDifficultyMeasure(const char *const *words, int count, WordDifficulty *out);
+
+// every feature, the solver only considers words of the same list and the same length as candidates, so a list
+// split by word length scores exactly like the whole list. False if memory ran out
+bool wordDifficultyScore(const char *const *words, int count, WordDifficulty *out);
+
+// fingerprint of a word list, ties a saved index to the exact list it was computed from
+uint32_t wordDifficultyHashWords(const char *const *words, int count);
+
+bool wordDifficultySave(const char *path, uint32_t hash, const WordDifficulty *difficulty, int count);
+
+bool wordDifficultyLoad(const char *path, uint32_t hash, WordDifficulty *difficulty, int count);
+
+const char *wordDifficultyBandName(DifficultyBand band);
+
+// returns DIFFICULTY_BANDS if the name is unknown
+DifficultyBand wordDifficultyFindBand(const char *name);
+
+#endif
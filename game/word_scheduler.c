@@ -0,0 +1,149 @@
+#include <string.h>
+
+#include "word_scheduler.h"
+
+// four feistel rounds shuffle well enough for word order and cost a few multiplies each
+#define FEISTEL_ROUNDS 4
+
+static uint32_t nextRandom(WordScheduler *scheduler) {
+    scheduler->rng ^= scheduler->rng << 13;
+    scheduler->rng ^= scheduler->rng >> 7;
+    scheduler->rng ^= scheduler->rng << 17;
+    return (uint32_t) (scheduler->rng >> 16);
+}
+
+static uint32_t mix(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+static uint32_t hashName(const char *name) {
+    uint32_t hash = 2166136261u;
+    for (; *name; name++) {
+        hash ^= (unsigned char) *name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Feistel network over [0, 2^(2 * halfBits)), a bijection for every key
+ *
+ * @param value value to encrypt
+ * @param key key of the permutation
+ * @param halfBits bits of each half
+ * @return position value is moved to
+ */
+static uint32_t feistel(uint32_t value, uint32_t key, int halfBits) {
+    uint32_t mask = (1u << halfBits) - 1;
+    uint32_t left = value >> halfBits;
+    uint32_t right = value & mask;
+
+    for (uint32_t round = 0; round < FEISTEL_ROUNDS; round++) {
+        uint32_t f = mix(right ^ key ^ (round * 0x9E3779B9u)) & mask;
+        uint32_t newLeft = right;
+        right = left ^ f;
+        left = newLeft;
+    }
+    return (left << halfBits) | right;
+}
+
+/**
+ * Maps an index to its place in a random permutation of [0, size) without storing the permutation.
+ * Values past size are encrypted again (cycle walking), the domain is less than 4 times size so
+ * this takes under 4 steps on average
+ *
+ * @param index position in the cycle, below size
+ * @param key key of the permutation
+ * @param size number of elements
+ * @return element at that position
+ */
+static uint32_t permute(uint32_t index, uint32_t key, uint32_t size) {
+    int halfBits = 1;
+    while (halfBits < 16 && (1ull << (2 * halfBits)) < size) halfBits++;
+
+    uint32_t value = index;
+    do {
+        value = feistel(value, key, halfBits);
+    } while (value >= size);
+    return value;
+}
+
+/**
+ * Prepares a scheduler that hasn't handed out any word yet
+ *
+ * @param scheduler scheduler to initialise
+ * @param seed anything that differs between players and runs, e.g. the time
+ */
+void wordSchedulerInit(WordScheduler *scheduler, uint64_t seed) {
+    memset(scheduler, 0, sizeof(WordScheduler));
+    scheduler->rng = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 8; i++) nextRandom(scheduler);
+}
+
+/**
+ * Starts a new cycle through a category with a fresh permutation
+ */
+static void startCycle(WordScheduler *scheduler, CategorySchedule *schedule, const WordCategory *category) {
+    bool sameList = schedule->size == (uint32_t) category->wordCount && schedule->nameHash == hashName(category->name);
+    schedule->size = (uint32_t) category->wordCount;
+    schedule->nameHash = hashName(category->name);
+    schedule->next = 0;
+    if (!sameList) schedule->lastWord = -1;
+
+    // the last word of a cycle could come first in the next one, a few other keys avoid that
+    for (int attempt = 0; attempt < 8; attempt++) {
+        schedule->key = nextRandom(scheduler);
+        if (schedule->size < 2 || (int32_t) permute(0, schedule->key, schedule->size) != schedule->lastWord) break;
+    }
+}
+
+/**
+ * Returns the next word of a category for this player, in O(1) time and without per word memory
+ *
+ * @param scheduler the player's scheduler
+ * @param corpus corpus the ids refer to
+ * @param category index of the category, -1 for a random one
+ * @return word id, -1 if there are no words
+ */
+int wordSchedulerNext(WordScheduler *scheduler, const WordCorpus *corpus, int category) {
+    if (corpus->categoryCount == 0 || category >= corpus->categoryCount) return -1;
+    if (category < 0) category = (int) (nextRandom(scheduler) % (uint32_t) corpus->categoryCount);
+
+    const WordCategory *cat = &corpus->categories[category];
+    if (cat->wordCount == 0) return -1;
+    CategorySchedule *schedule = &scheduler->categories[category];
+
+    // a reload that changed the list invalidates the cycle, so does running out of words
+    if (schedule->size != (uint32_t) cat->wordCount || schedule->nameHash != hashName(cat->name) ||
+        schedule->next >= schedule->size) {
+        startCycle(scheduler, schedule, cat);
+    }
+
+    uint32_t offset = permute(schedule->next++, schedule->key, schedule->size);
+    schedule->lastWord = (int32_t) offset;
+    return cat->firstWord + (int) offset;
+}
+
+/**
+ * Starts a new game on the player's next word of a random category
+ *
+ * @param scheduler the player's scheduler
+ * @param corpus loaded corpus
+ * @param game GameState struct to initialise in place
+ * @param lives amount of the initial lives
+ * @return false if the corpus has no words
+ */
+bool wordSchedulerStartGame(WordScheduler *scheduler, const WordCorpus *corpus, GameState *game, int lives) {
+    int wordId = wordSchedulerNext(scheduler, corpus, -1);
+    if (wordId < 0) return false;
+
+    const WordCategory *category = &corpus->categories[wordCorpusGetCategoryOfWord(corpus, wordId)];
+    initHangmanInPlace(game, category->name, wordCorpusGetWord(corpus, wordId), lives);
+    game->wordId = wordId;
+    return true;
+}
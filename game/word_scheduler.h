@@ -0,0 +1,32 @@
+#ifndef WORD_SCHEDULER_H
+#define WORD_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hangman.h"
+#include "word_corpus.h"
+
+// where one category is in its current shuffle, the order itself is never stored
+typedef struct {
+    uint32_t key;      // picks the permutation of this cycle
+    uint32_t next;     // position of the next word in the permutation
+    uint32_t size;     // words in the category when the cycle started, 0 before the first pick
+    uint32_t nameHash; // notices when a reload put another list at this index
+    int32_t lastWord;  // last word handed out, a new cycle never starts with it
+} CategorySchedule;
+
+// hands out every word of a category once before any word repeats, one per player
+typedef struct {
+    uint64_t rng;
+    CategorySchedule categories[MAX_CATEGORIES];
+} WordScheduler;
+
+void wordSchedulerInit(WordScheduler *scheduler, uint64_t seed);
+
+// next word id of a category, category -1 picks a random category; -1 if the corpus is empty
+int wordSchedulerNext(WordScheduler *scheduler, const WordCorpus *corpus, int category);
+
+bool wordSchedulerStartGame(WordScheduler *scheduler, const WordCorpus *corpus, GameState *game, int lives);
+
+#endif
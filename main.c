@@ -1,37 +1,126 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
 #include "screens/main_menu.h"
 #include "screens/about_section.h"
 #include "screens/ingame_ui.h"
 #include "screens/loading_screen.h"
+#include "screens/render_thread.h"
 #include "game/hangman.h"
+#include "game/word_corpus.h"
+#include "game/game_snapshot.h"
+#include "game/corpus_watcher.h"
+#include "game/word_scheduler.h"
 #include "screens/graphics/texture_manager.h"
+#include "screens/graphics/font_manager.h"
 #include "utility/utilities.h"
+#include "profiling/replay.h"
+#include "profiling/startup_timer.h"
+#include "profiling/alloc_tracker.h"
+#include "profiling/input_latency.h"
 
 #define SDL_MAIN_HANDLED
 
+//game logic runs at a fixed tick, a frame that falls further behind than MAX_UPDATE_STEPS ticks drops the rest
+#define UPDATE_STEP (1.0f / 60.0f)
+#define MAX_UPDATE_STEPS 5
+
+//unfinished game is kept here so a crashed or restarted kiosk can resume it
+#define SESSION_FILE "session.bin"
+
+//shuffled word order of the player, no word comes back before the whole category was played
+static WordScheduler g_playerWords;
+
+static uint8_t g_savedRecord[GAME_SNAPSHOT_MAX_BYTES];
+static size_t g_savedRecordLen = 0;
+static unsigned int g_savedRound = 0;
+static unsigned int g_savedVersion = 0;
+
+//writes the session file only if the game changed since the last save
+static void autosaveSession(const WordCorpus *corpus, const GameState *game, unsigned int round) {
+    //most events don't touch the game, the round and version say so without encoding it
+    if (g_savedRecordLen && round == g_savedRound && game->version == g_savedVersion) return;
+    g_savedRound = round;
+    g_savedVersion = game->version;
+
+    uint8_t record[GAME_SNAPSHOT_MAX_BYTES];
+    size_t len = gameSnapshotEncode(game, corpus, record, sizeof(record));
+    if (!len) return;
+    if (len == g_savedRecordLen && memcmp(record, g_savedRecord, len) == 0) return;
+
+    if (gameSnapshotSaveFile(SESSION_FILE, corpus, game, 1)) {
+        memcpy(g_savedRecord, record, len);
+        g_savedRecordLen = len;
+    }
+}
+
+static void clearSession(void) {
+    remove(SESSION_FILE);
+    g_savedRecordLen = 0;
+}
+
 int main(int argc, char *argv[]) {
+    startupTimerBegin();
+
+    //one seed drives every random choice, a replay brings back the one it was recorded with
+    uint64_t seed = (uint64_t) time(NULL) ^ SDL_GetPerformanceCounter();
+
+    //--startup-bench quits after the first menu frame and prints how long each startup phase took
+    bool startupBench = false;
+
+    //--alloc-report counts allocations per frame of every screen, --alloc-check also fails if a steady frame allocated
+    bool allocCheck = false;
+
+    //--latency-report writes the key to present latency histogram and samples there on exit
+    const char *latencyFile = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            if (!replayStartRecording(argv[++i], seed)) return 1;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            if (!replayStartPlayback(argv[++i], &seed)) return 1;
+        } else if (strcmp(argv[i], "--startup-bench") == 0) {
+            startupBench = true;
+        } else if (strcmp(argv[i], "--alloc-report") == 0 || strcmp(argv[i], "--alloc-check") == 0) {
+            allocCheck = allocCheck || strcmp(argv[i], "--alloc-check") == 0;
+            if (!allocTrackerInstall()) return 1;
+        } else if (strcmp(argv[i], "--latency-report") == 0 && i + 1 < argc) {
+            latencyFile = argv[++i];
+        }
+    }
+    bool headless = replayGetMode() == REPLAY_PLAY;
+
     //initialise OpenGL attributes in SDL2
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
-    if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
+    //replays render offscreen in software, SDL_VIDEODRIVER can still pick another driver
+    if (headless) {
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    }
+
+    if (SDL_Init(headless ? SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTS : SDL_INIT_EVERYTHING) < 0) {
         printf("SDL Init failed: %s\n", SDL_GetError());
         return 1;
     }
+    startupTimerMark(STARTUP_SDL_INIT);
     if (TTF_Init() == -1) {
         printf("TTF Init failed: %s\n", TTF_GetError());
         SDL_Quit();
         return 1;
     }
+    startupTimerMark(STARTUP_TTF_INIT);
 
     SDL_Window *window = SDL_CreateWindow("Hangman",
                                           SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720,
-                                          SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
+                                          headless ? SDL_WINDOW_HIDDEN
+                                                   : SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
     SDL_Renderer *renderer =
-            SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+            SDL_CreateRenderer(window, -1, headless ? SDL_RENDERER_SOFTWARE
+                                                    : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
 
     //initialise our renderer
     if (!renderer) {
@@ -39,11 +128,29 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    //replays run as fast as they can, a real display paces skipped frames like presented ones
+    if (!headless) {
+        SDL_DisplayMode displayMode;
+        bool known = SDL_GetWindowDisplayMode(window, &displayMode) == 0 && displayMode.refresh_rate > 0;
+        renderUiSetRefreshRate(known ? displayMode.refresh_rate : 60);
+    }
+    startupTimerMark(STARTUP_WINDOW);
+
+    //load every word list into memory, needed to save and restore sessions
+    //lists changed while the game runs are reloaded in the background and picked up by the next round
+    if (!corpusWatcherStart("resources/words")) {
+        printf("[WARNING] Failed to load word corpus, sessions won't be saved\n");
+    }
+    srand((unsigned) seed);
+    wordSchedulerInit(&g_playerWords, seed);
+    startupTimerMark(STARTUP_WORD_LISTS);
+
     //initialize our loading screen
     if (!loadingScreenInit(window, renderer)) {
         printf("Loading screen init failed\n");
         return 1;
     }
+    startupTimerMark(STARTUP_LOADING_SCREEN);
 
     //start async texture loading (on background thread)
     if (!textureManagerStartAsyncLoad()) {
@@ -59,26 +166,40 @@ int main(int argc, char *argv[]) {
             if (event.type == SDL_QUIT) {
                 loadingScreenDestroy();
                 textureManagerDestroyAll();
+                fontManagerDestroy();
+                corpusWatcherStop();
                 SDL_DestroyRenderer(renderer);
                 SDL_DestroyWindow(window);
                 TTF_Quit();
                 SDL_Quit();
                 return 0;
             }
+            //window contents may have been lost, redraw even if progress didn't move
+            if (event.type == SDL_WINDOWEVENT) {
+                loadingScreenInvalidate();
+            }
         }
 
         float progress = textureManagerGetProgress();
         loadingScreenRender(renderer, window, progress);
 
+        //the loader thread allocates the whole time, these frames are never steady
+        allocTrackerFrameEnd(ALLOC_SCREEN_LOADING, true);
+
         //check if surfaces are loaded
         if (textureManagerSurfacesLoaded()) {
+            startupTimerMark(STARTUP_SURFACE_LOAD);
+
             //now convert surfaces to textures on main thread
             if (textureManagerProcessLoadedSurfaces(renderer)) {
+                startupTimerMark(STARTUP_TEXTURE_UPLOAD);
                 loadingComplete = true;
+                break;
             }
         }
 
-        SDL_Delay(16); // ~60 FPS
+        //the benchmark polls more often so the surface load isn't rounded up to whole frames
+        SDL_Delay(startupBench ? 1 : 16); // ~60 FPS
     }
 
     //destroy loading screen
@@ -87,6 +208,7 @@ int main(int argc, char *argv[]) {
     //initialise ui menus using textures that we loaded already
     if (!mainMenuInit(window, renderer)) return 1;
     if (!aboutSectionInit(window, renderer)) return 1;
+    startupTimerMark(STARTUP_MENU_INIT);
 
     bool shouldQuit = false;
     bool inMenu = true;
@@ -95,35 +217,76 @@ int main(int argc, char *argv[]) {
 
     GameState game;
 
+    //recorded sessions always start from the menu and leave the saved session alone
+    bool keepSession = replayGetMode() == REPLAY_OFF && !startupBench;
+
+    //resume an unfinished game left behind by a crash or restart
+    if (keepSession && gameSnapshotLoadFile(SESSION_FILE, corpusWatcherGet(), &game, 1) == 1 && !isGameOver(&game)) {
+        if (ingameUiInit(window, &game, &g_playerWords)) {
+            inMenu = false;
+            inGame = true;
+        }
+    }
+
+    if (!replayBegin(window)) {
+        shouldQuit = true;
+    }
+
+    //replays, benchmarks and allocation counts need every frame drawn in step with the logic, so they render inline,
+    //as does every renderer that isn't OpenGL
+    bool renderThreaded = !headless && !startupBench && !allocTrackerEnabled() && renderThreadStart(window, renderer);
+
     //timing
     Uint64 lastTime = SDL_GetPerformanceCounter();
+    float updateLag = 0.0f; //game time not yet simulated by a fixed tick
+    bool showProfiler = false;
 
     while (!shouldQuit) {
+        bool sessionDirty = false;
+        bool frameInput = false;
+
+        //the render thread draws every refresh on its own, sleep until input arrives or the next tick is due
+        if (renderThreaded) {
+            int waitMs = (int) ((UPDATE_STEP - updateLag) * 1000.0f);
+            if (waitMs > 0) SDL_WaitEventTimeout(NULL, waitMs);
+        }
+
         SDL_Event event;
-        while (SDL_PollEvent(&event)) {
+        while (replayPollEvent(&event)) {
+            frameInput = true;
+
             //window close
             if (event.type == SDL_QUIT) {
                 shouldQuit = true;
             }
 
+            //profiler overlay works on every screen
+            if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) {
+                showProfiler = !showProfiler;
+                continue;
+            }
+
             //main menu input handling
             if (inMenu) {
                 MenuAction action =
                         mainMenuHandleEvent(window, renderer, &event);
 
                 if (action == MENU_START) {
-                    char *wordFile = getRandomWordFileName();
-                    char *word = getRandomWordFromFile(wordFile);
-                    if (!word) {
-                        printf("Failed to get word\n");
-                        shouldQuit = true;
-                        break;
-                    }
+                    //words come straight from the corpus, the lists are only read again if it failed to load
+                    if (!wordSchedulerStartGame(&g_playerWords, corpusWatcherGet(), &game, 6)) {
+                        char *wordFile = getRandomWordFileName();
+                        char *word = getRandomWordFromFile(wordFile);
+                        if (!word) {
+                            printf("Failed to get word\n");
+                            shouldQuit = true;
+                            break;
+                        }
 
-                    game = initHangman(wordFile, word, 6);
-                    free(word);
+                        initHangmanInPlace(&game, wordFile, word, 6);
+                        free(word);
+                    }
 
-                    if (!ingameUiInit(window, renderer, &game)) {
+                    if (!ingameUiInit(window, &game, &g_playerWords)) {
                         printf("Ingame UI failed\n");
                         shouldQuit = true;
                         break;
@@ -131,6 +294,7 @@ int main(int argc, char *argv[]) {
 
                     inMenu = false;
                     inGame = true;
+                    updateLag = 0.0f;
                 } else if (action == MENU_ABOUT) {
                     inMenu = false;
                     inAbout = true;
@@ -149,40 +313,94 @@ int main(int argc, char *argv[]) {
             //IN-GAME INPUT
             else if (inGame) {
                 ingameUiHandleEvent(&event);
+                sessionDirty = true;
             }
         }
 
+        //playback ran out of recorded frames
+        if (replayFinished()) {
+            break;
+        }
+
+        if (inGame && sessionDirty && keepSession) {
+            autosaveSession(corpusWatcherGet(), &game, ingameUiRound());
+        }
+
         //time step
         Uint64 current = SDL_GetPerformanceCounter();
-        float deltaTime =
-                (float) (current - lastTime) / SDL_GetPerformanceFrequency();
+        float deltaTime = replayFrameTime(
+                (float) (current - lastTime) / SDL_GetPerformanceFrequency());
         lastTime = current;
 
-        //render
+        //snapshot of what the current screen draws
+        UiSnapshot snap = {0};
+        SDL_GetWindowSize(window, &snap.winW, &snap.winH);
+        snap.profiler = showProfiler;
         if (inMenu) {
-            mainMenuRender(renderer, window);
+            snap.screen = UI_SCREEN_MENU;
+            mainMenuSnapshot(&snap.menu);
         } else if (inAbout) {
-            aboutSectionRender(renderer, window);
+            snap.screen = UI_SCREEN_ABOUT;
         } else if (inGame) {
-            ingameUiUpdate(deltaTime);
-            ingameUiRender(renderer, window);
-
-            //return to menu if user pressed Esc after game over
-            if (ingameUiShouldQuit()) {
-                setShouldQuit(false); //reset flag
-                ingameUiDestroy();
-                inGame = false;
-                inMenu = true;
+            updateLag += deltaTime;
+            int steps = 0;
+            while (updateLag >= UPDATE_STEP && steps < MAX_UPDATE_STEPS) {
+                ingameUiUpdate(UPDATE_STEP);
+                updateLag -= UPDATE_STEP;
+                steps++;
             }
+            //too far behind to catch up, skip ahead instead of spiralling into ever longer frames
+            if (updateLag >= UPDATE_STEP) updateLag = 0.0f;
+
+            snap.screen = UI_SCREEN_INGAME;
+            ingameUiSnapshot(&snap.ingame, updateLag);
+        }
+
+        //render
+        if (renderThreaded) {
+            renderThreadPublish(&snap);
+        } else {
+            renderUiSnapshot(renderer, &snap);
+            allocTrackerFrameEnd(inMenu ? ALLOC_SCREEN_MENU : inAbout ? ALLOC_SCREEN_ABOUT : ALLOC_SCREEN_INGAME,
+                                 frameInput);
         }
+
+        if (inMenu && startupBench) {
+            startupTimerMark(STARTUP_FIRST_FRAME);
+            startupTimerReport();
+            shouldQuit = true;
+        }
+
+        //return to menu if user pressed Esc after game over
+        if (inGame && ingameUiShouldQuit()) {
+            setShouldQuit(false); //reset flag
+            ingameUiDestroy();
+            if (keepSession) clearSession();
+            inGame = false;
+            inMenu = true;
+        }
+
+        //nothing holds on to the corpus between frames, so replaced word lists can be freed now
+        corpusWatcherQuiesce();
     }
 
+    renderThreadStop();
+    renderUiRelease();
+    inputLatencyReport();
+    if (latencyFile) inputLatencyExport(latencyFile);
+
+    replayStop();
+    allocTrackerReport();
+    int exitCode = allocCheck && allocTrackerSteadyViolations() > 0 ? 1 : 0;
+
     //destroy screens on exit
     textureManagerDestroyAll();
+    fontManagerDestroy();
+    corpusWatcherStop();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     TTF_Quit();
     SDL_Quit();
 
-    return 0;
+    return exitCode;
 }
\ No newline at end of file
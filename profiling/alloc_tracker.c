@@ -0,0 +1,132 @@
+#define ALLOC_TRACKER_NO_HOOKS
+#include "alloc_tracker.h"
+
+#include <stdio.h>
+
+// input can rebuild cached text and layouts, the about section even waits 150ms before it does
+#define STEADY_AFTER_MS 500
+
+static const char *screenNames[ALLOC_SCREENS] = {"loading", "menu", "about", "ingame"};
+static const char *objectNames[ALLOC_OBJECTS] = {"surfaces", "textures", "fonts"};
+
+typedef struct {
+    uint64_t frames;
+    AllocCounts total;
+    uint64_t steadyFrames;
+    uint64_t steadyAllocating;
+    uint64_t worstFrame;
+} ScreenStats;
+
+static bool enabled = false;
+static SDL_malloc_func realMalloc;
+static SDL_calloc_func realCalloc;
+static SDL_realloc_func realRealloc;
+static SDL_free_func realFree;
+
+//bumped from any thread, the about section rasterizes its layout on a worker
+static SDL_atomic_t allocCount;
+static SDL_atomic_t allocBytes;
+static SDL_atomic_t objectCounts[ALLOC_OBJECTS];
+
+static ScreenStats stats[ALLOC_SCREENS];
+static int lastScreen = -1;
+static Uint32 quietSince = 0;
+
+static void *countingMalloc(size_t size) {
+    SDL_AtomicAdd(&allocCount, 1);
+    SDL_AtomicAdd(&allocBytes, (int) size);
+    return realMalloc(size);
+}
+
+static void *countingCalloc(size_t count, size_t size) {
+    SDL_AtomicAdd(&allocCount, 1);
+    SDL_AtomicAdd(&allocBytes, (int) (count * size));
+    return realCalloc(count, size);
+}
+
+static void *countingRealloc(void *mem, size_t size) {
+    SDL_AtomicAdd(&allocCount, 1);
+    SDL_AtomicAdd(&allocBytes, (int) size);
+    return realRealloc(mem, size);
+}
+
+static void countingFree(void *mem) {
+    realFree(mem);
+}
+
+bool allocTrackerInstall(void) {
+    if (enabled) return true;
+    SDL_GetMemoryFunctions(&realMalloc, &realCalloc, &realRealloc, &realFree);
+    if (SDL_SetMemoryFunctions(countingMalloc, countingCalloc, countingRealloc, countingFree) != 0) {
+        printf("[ERROR] Failed to install allocation tracking: %s\n", SDL_GetError());
+        return false;
+    }
+    enabled = true;
+    return true;
+}
+
+bool allocTrackerEnabled(void) {
+    return enabled;
+}
+
+void *allocTrackerObject(AllocObject type, void *object) {
+    if (enabled && object) SDL_AtomicAdd(&objectCounts[type], 1);
+    return object;
+}
+
+void allocTrackerTake(AllocCounts *out) {
+    out->allocations = (uint64_t) SDL_AtomicSet(&allocCount, 0);
+    out->bytes = (uint64_t) SDL_AtomicSet(&allocBytes, 0);
+    for (int i = 0; i < ALLOC_OBJECTS; i++) {
+        out->objects[i] = (uint64_t) SDL_AtomicSet(&objectCounts[i], 0);
+    }
+}
+
+void allocTrackerFrameEnd(AllocScreen screen, bool input) {
+    if (!enabled) return;
+
+    AllocCounts frame;
+    allocTrackerTake(&frame);
+
+    Uint32 now = SDL_GetTicks();
+    if (input || (int) screen != lastScreen) quietSince = now;
+    lastScreen = screen;
+
+    ScreenStats *s = &stats[screen];
+    s->frames++;
+    s->total.allocations += frame.allocations;
+    s->total.bytes += frame.bytes;
+    for (int i = 0; i < ALLOC_OBJECTS; i++) s->total.objects[i] += frame.objects[i];
+    if (frame.allocations > s->worstFrame) s->worstFrame = frame.allocations;
+
+    if (now - quietSince >= STEADY_AFTER_MS) {
+        s->steadyFrames++;
+        if (frame.allocations) s->steadyAllocating++;
+    }
+}
+
+void allocTrackerReport(void) {
+    if (!enabled) return;
+
+    printf("%-8s %8s %10s %10s %8s %9s %9s %6s   %s\n", "screen", "frames", "allocs/f", "bytes/f", "worst",
+           "steady", "allocate", "", "objects created");
+    for (int i = 0; i < ALLOC_SCREENS; i++) {
+        const ScreenStats *s = &stats[i];
+        if (!s->frames) continue;
+        printf("%-8s %8llu %10.2f %10.1f %8llu %9llu %9llu %6s  ", screenNames[i],
+               (unsigned long long) s->frames, (double) s->total.allocations / s->frames,
+               (double) s->total.bytes / s->frames, (unsigned long long) s->worstFrame,
+               (unsigned long long) s->steadyFrames, (unsigned long long) s->steadyAllocating,
+               s->steadyAllocating ? "FAIL" : "");
+        for (int o = 0; o < ALLOC_OBJECTS; o++) {
+            printf(" %llu %s", (unsigned long long) s->total.objects[o], objectNames[o]);
+        }
+        printf("\n");
+    }
+}
+
+int allocTrackerSteadyViolations(void) {
+    int violations = 0;
+    for (int i = 0; i < ALLOC_SCREENS; i++) violations += (int) stats[i].steadyAllocating;
+    return violations;
+}
@@ -0,0 +1,78 @@
+#ifndef HANGMAN_ALLOC_TRACKER_H
+#define HANGMAN_ALLOC_TRACKER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Opt-in allocation counting. Once installed, every SDL_malloc/calloc/realloc goes through a counter, and the
+ * surfaces, textures and fonts the screens create are counted by the macros at the end of this header.
+ * allocTrackerFrameEnd hands the counts to the screen that drew the frame; a frame is steady once the screen
+ * went half a second without input, and steady frames are expected not to allocate at all
+ */
+
+typedef enum {
+    ALLOC_SCREEN_LOADING,
+    ALLOC_SCREEN_MENU,
+    ALLOC_SCREEN_ABOUT,
+    ALLOC_SCREEN_INGAME,
+    ALLOC_SCREENS
+} AllocScreen;
+
+typedef enum {
+    ALLOC_OBJECT_SURFACE,
+    ALLOC_OBJECT_TEXTURE,
+    ALLOC_OBJECT_FONT,
+    ALLOC_OBJECTS
+} AllocObject;
+
+typedef struct {
+    uint64_t allocations;
+    uint64_t bytes;
+    uint64_t objects[ALLOC_OBJECTS];
+} AllocCounts;
+
+// swaps in the counting memory functions, has to run before SDL allocates anything
+bool allocTrackerInstall(void);
+
+bool allocTrackerEnabled(void);
+
+// counts object if it isn't NULL and passes it through
+void *allocTrackerObject(AllocObject type, void *object);
+
+// counts since the last take, then starts over
+void allocTrackerTake(AllocCounts *out);
+
+// closes the frame drawn by screen, input tells whether it handled any events
+void allocTrackerFrameEnd(AllocScreen screen, bool input);
+
+// allocations and bytes per frame of every screen, steady frames separately
+void allocTrackerReport(void);
+
+// steady frames that allocated
+int allocTrackerSteadyViolations(void);
+
+// object creation in the screens, only counted while the tracker is installed
+#ifndef ALLOC_TRACKER_NO_HOOKS
+#define SDL_CreateTextureFromSurface(renderer, surface) \
+    ((SDL_Texture *) allocTrackerObject(ALLOC_OBJECT_TEXTURE, SDL_CreateTextureFromSurface(renderer, surface)))
+#define SDL_CreateRGBSurface(flags, w, h, depth, rmask, gmask, bmask, amask) \
+    ((SDL_Surface *) allocTrackerObject(ALLOC_OBJECT_SURFACE, \
+                                        SDL_CreateRGBSurface(flags, w, h, depth, rmask, gmask, bmask, amask)))
+#define SDL_CreateRGBSurfaceWithFormat(flags, w, h, depth, format) \
+    ((SDL_Surface *) allocTrackerObject(ALLOC_OBJECT_SURFACE, \
+                                        SDL_CreateRGBSurfaceWithFormat(flags, w, h, depth, format)))
+#define TTF_OpenFont(file, size) \
+    ((TTF_Font *) allocTrackerObject(ALLOC_OBJECT_FONT, TTF_OpenFont(file, size)))
+#define TTF_OpenFontRW(src, freesrc, size) \
+    ((TTF_Font *) allocTrackerObject(ALLOC_OBJECT_FONT, TTF_OpenFontRW(src, freesrc, size)))
+#define TTF_RenderText_Blended(font, text, color) \
+    ((SDL_Surface *) allocTrackerObject(ALLOC_OBJECT_SURFACE, TTF_RenderText_Blended(font, text, color)))
+#define TTF_RenderText_Blended_Wrapped(font, text, color, wrap) \
+    ((SDL_Surface *) allocTrackerObject(ALLOC_OBJECT_SURFACE, \
+                                        TTF_RenderText_Blended_Wrapped(font, text, color, wrap)))
+#endif
+
+#endif
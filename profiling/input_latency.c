@@ -0,0 +1,118 @@
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "input_latency.h"
+
+// last samples kept for percentiles and the export, the histogram counts every one
+#define MAX_SAMPLES 4096
+
+typedef struct {
+    Uint32 frame;
+    float ms;
+} LatencySample;
+
+static const float bucketEdges[LATENCY_BUCKETS - 1] = {8, 16, 24, 33, 50, 66, 100, 150, 250};
+static const char *bucketLabels[LATENCY_BUCKETS] = {
+    "<8ms", "<16ms", "<24ms", "<33ms", "<50ms", "<66ms", "<100ms", "<150ms", "<250ms", ">=250ms"
+};
+
+static LatencySample samples[MAX_SAMPLES];
+static int sampleCount = 0; // every sample, the ring holds the last MAX_SAMPLES of them
+static int buckets[LATENCY_BUCKETS];
+static double totalMs = 0;
+static double maxMs = 0;
+
+static Uint32 presentedFrames = 0;
+static Uint64 lastKeyTime = 0;
+
+// sorted copy for percentiles, kept static so the overlay doesn't allocate every frame
+static float sorted[MAX_SAMPLES];
+
+Uint64 inputLatencyKeyTime(const SDL_Event *event) {
+    if (event->type != SDL_KEYDOWN) return 0;
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // move back by the time the event sat in the queue, replayed events carry no usable timestamp
+    Uint32 ticks = SDL_GetTicks();
+    Uint32 queued = event->key.timestamp && event->key.timestamp <= ticks ? ticks - event->key.timestamp : 0;
+    if (queued > 1000) queued = 0;
+    Uint64 back = (Uint64) queued * SDL_GetPerformanceFrequency() / 1000;
+    return now > back ? now - back : now;
+}
+
+void inputLatencyFramePresented(Uint64 keyTime) {
+    presentedFrames++;
+    if (!keyTime || keyTime == lastKeyTime) return;
+    lastKeyTime = keyTime;
+
+    float ms = (float) ((double) (SDL_GetPerformanceCounter() - keyTime) * 1000.0 / SDL_GetPerformanceFrequency());
+    samples[sampleCount % MAX_SAMPLES] = (LatencySample) {presentedFrames, ms};
+    sampleCount++;
+
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && ms >= bucketEdges[bucket]) bucket++;
+    buckets[bucket]++;
+    totalMs += ms;
+    if (ms > maxMs) maxMs = ms;
+}
+
+static int compareFloats(const void *a, const void *b) {
+    float x = *(const float *) a, y = *(const float *) b;
+    return (x > y) - (x < y);
+}
+
+void inputLatencyStats(LatencyStats *out) {
+    memset(out, 0, sizeof(LatencyStats));
+    out->count = sampleCount;
+    memcpy(out->buckets, buckets, sizeof(buckets));
+    if (!sampleCount) return;
+
+    int kept = sampleCount < MAX_SAMPLES ? sampleCount : MAX_SAMPLES;
+    for (int i = 0; i < kept; i++) sorted[i] = samples[i].ms;
+    qsort(sorted, kept, sizeof(float), compareFloats);
+
+    out->meanMs = totalMs / sampleCount;
+    out->p50Ms = sorted[kept / 2];
+    out->p95Ms = sorted[kept * 95 / 100];
+    out->maxMs = maxMs;
+}
+
+const char *inputLatencyBucketLabel(int bucket) {
+    return bucket >= 0 && bucket < LATENCY_BUCKETS ? bucketLabels[bucket] : "";
+}
+
+void inputLatencyReport(void) {
+    LatencyStats stats;
+    inputLatencyStats(&stats);
+    if (!stats.count) return;
+
+    printf("key to present: %d presses, mean %.2f ms, p50 %.2f ms, p95 %.2f ms, max %.2f ms\n", stats.count,
+           stats.meanMs, stats.p50Ms, stats.p95Ms, stats.maxMs);
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        printf("%-8s %6d %5.1f%%\n", bucketLabels[i], stats.buckets[i], stats.buckets[i] * 100.0 / stats.count);
+    }
+}
+
+bool inputLatencyExport(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        printf("[ERROR] Failed to write latency report %s\n", path);
+        return false;
+    }
+
+    fprintf(file, "bucket,count\n");
+    for (int i = 0; i < LATENCY_BUCKETS; i++) fprintf(file, "%s,%d\n", bucketLabels[i], buckets[i]);
+
+    // oldest kept sample first
+    int kept = sampleCount < MAX_SAMPLES ? sampleCount : MAX_SAMPLES;
+    fprintf(file, "\nframe,latency_ms\n");
+    for (int i = sampleCount - kept; i < sampleCount; i++) {
+        const LatencySample *sample = &samples[i % MAX_SAMPLES];
+        fprintf(file, "%u,%.3f\n", (unsigned) sample->frame, sample->ms);
+    }
+
+    fclose(file);
+    return true;
+}
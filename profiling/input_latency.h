@@ -0,0 +1,42 @@
+#ifndef HANGMAN_INPUT_LATENCY_H
+#define HANGMAN_INPUT_LATENCY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/*
+ * Key to present latency. A key press that changes the revealed word is stamped when SDL queued it, and the
+ * stamp rides along in the ingame snapshots until the first frame showing the change has been presented; that
+ * frame gets tagged with the time in between. Samples are recorded, read by the overlay and exported on the
+ * thread that presents, or after it stopped
+ */
+
+#define LATENCY_BUCKETS 10
+
+typedef struct {
+    int count;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double maxMs;
+    int buckets[LATENCY_BUCKETS]; //samples below each bucket's upper edge, the last one is open ended
+} LatencyStats;
+
+// performance counter value of when SDL queued the event, 0 for anything but a key press
+Uint64 inputLatencyKeyTime(const SDL_Event *event);
+
+// closes a presented frame, keyTime is the stamp of the key press its content reflects, 0 if there is none
+void inputLatencyFramePresented(Uint64 keyTime);
+
+void inputLatencyStats(LatencyStats *out);
+
+// "<16ms" and the like
+const char *inputLatencyBucketLabel(int bucket);
+
+// prints the histogram and percentiles, nothing if no key press was presented
+void inputLatencyReport(void);
+
+// the histogram followed by every kept sample with the frame it was presented in, as csv
+bool inputLatencyExport(const char *path);
+
+#endif
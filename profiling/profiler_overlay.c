@@ -0,0 +1,88 @@
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "profiler_overlay.h"
+#include "input_latency.h"
+#include "../screens/graphics/bitmap_font.h"
+#include "../screens/graphics/font_manager.h"
+
+#define PANEL_X 8
+#define PANEL_Y 8
+#define PANEL_W 360
+#define PADDING 8
+#define LABEL_W 80
+#define BAR_W 200
+
+static BitmapFont font;
+static bool fontLoaded = false;
+
+// frame to frame time, averaged over roughly the last ten frames
+static Uint64 lastFrame = 0;
+static double frameMs = 0;
+
+static void drawLine(SDL_Renderer *renderer, const char *text, int x, int *y) {
+    SDL_Color white = {255, 255, 255, 255};
+    bitmapFontDraw(renderer, &font, text, x, *y, white);
+    *y += font.lineHeight + 2;
+}
+
+void profilerOverlayRender(SDL_Renderer *renderer) {
+    if (!fontLoaded) {
+        fontLoaded = true;
+        if (!bitmapFontLoad(&font, renderer, FONT_PIXELIFY_SEMIBOLD, 16)) {
+            printf("[ERROR] Failed to bake profiler overlay font\n");
+        }
+    }
+    if (!bitmapFontIsLoaded(&font)) return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    double ms = lastFrame ? (double) (now - lastFrame) * 1000.0 / SDL_GetPerformanceFrequency() : 0;
+    lastFrame = now;
+    // the panel was hidden in between, start the average over
+    if (!frameMs || ms > 1000.0) frameMs = ms;
+    else frameMs += (ms - frameMs) * 0.1;
+
+    LatencyStats stats;
+    inputLatencyStats(&stats);
+
+    int lineH = font.lineHeight + 2;
+    SDL_Rect panel = {PANEL_X, PANEL_Y, PANEL_W, PADDING * 2 + lineH * (3 + LATENCY_BUCKETS)};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &panel);
+
+    int x = PANEL_X + PADDING;
+    int y = PANEL_Y + PADDING;
+    char line[128];
+
+    snprintf(line, sizeof(line), "frame %.2f ms (%.0f fps)", frameMs, frameMs > 0 ? 1000.0 / frameMs : 0.0);
+    drawLine(renderer, line, x, &y);
+    snprintf(line, sizeof(line), "key to present, %d presses", stats.count);
+    drawLine(renderer, line, x, &y);
+    snprintf(line, sizeof(line), "p50 %.1f  p95 %.1f  max %.1f ms", stats.p50Ms, stats.p95Ms, stats.maxMs);
+    drawLine(renderer, line, x, &y);
+
+    int most = 1;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        if (stats.buckets[i] > most) most = stats.buckets[i];
+    }
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        SDL_Rect bar = {x + LABEL_W, y + 2, stats.buckets[i] * BAR_W / most, lineH - 4};
+        SDL_SetRenderDrawColor(renderer, 90, 200, 120, 255);
+        SDL_RenderFillRect(renderer, &bar);
+
+        snprintf(line, sizeof(line), "%d", stats.buckets[i]);
+        SDL_Color white = {255, 255, 255, 255};
+        bitmapFontDraw(renderer, &font, inputLatencyBucketLabel(i), x, y, white);
+        bitmapFontDraw(renderer, &font, line, x + LABEL_W + bar.w + 4, y, white);
+        y += lineH;
+    }
+}
+
+void profilerOverlayRelease(void) {
+    bitmapFontDestroy(&font);
+    fontLoaded = false;
+    lastFrame = 0;
+    frameMs = 0;
+}
@@ -0,0 +1,16 @@
+#ifndef HANGMAN_PROFILER_OVERLAY_H
+#define HANGMAN_PROFILER_OVERLAY_H
+
+#include <SDL2/SDL.h>
+
+/*
+ * Panel drawn over any screen once F3 toggles it on: frame time and the key to present latency histogram.
+ * Lives on the thread that renders, like the screens it is drawn over
+ */
+
+// draws the panel into the current frame, call right before presenting it
+void profilerOverlayRender(SDL_Renderer *renderer);
+
+void profilerOverlayRelease(void);
+
+#endif
@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay.h"
+
+#define REPLAY_MAGIC "HRP1"
+#define REPLAY_HEADER_SIZE 12
+#define MAX_RECORD_BYTES 64
+
+// record tags, everything after the tag is varints so most records fit in a few bytes
+enum {
+    TAG_FRAME_END,
+    TAG_QUIT,
+    TAG_KEY_DOWN,
+    TAG_KEY_UP,
+    TAG_MOUSE_MOTION,
+    TAG_MOUSE_DOWN,
+    TAG_MOUSE_UP,
+    TAG_WINDOW
+};
+
+static struct {
+    ReplayMode mode;
+    FILE *file;
+    uint64_t seed;
+
+    SDL_Window *window;
+    uint8_t *data;
+    size_t size;
+    size_t pos;
+    bool frameEnded;
+    bool finished;
+    float frameTime;
+
+    // playback timings
+    int frames;
+    Uint64 startCounter;
+    Uint64 frameCounter;
+    double slowestFrame;
+} replay;
+
+static size_t putVarint(uint8_t *out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t) value;
+    return n;
+}
+
+static size_t putSigned(uint8_t *out, int64_t value) {
+    return putVarint(out, ((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+}
+
+/**
+ * Reads the next varint of the log, marks playback finished if the log is cut off
+ *
+ * @return the value, 0 past the end
+ */
+static uint64_t getVarint(void) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (replay.pos >= replay.size) {
+            replay.finished = true;
+            return 0;
+        }
+        uint8_t byte = replay.data[replay.pos++];
+        value |= (uint64_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    replay.finished = true;
+    return 0;
+}
+
+static int64_t getSigned(void) {
+    uint64_t value = getVarint();
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+static void putU32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (uint8_t) (value >> (8 * i));
+}
+
+static uint32_t getU32(const uint8_t *in) {
+    return in[0] | (uint32_t) in[1] << 8 | (uint32_t) in[2] << 16 | (uint32_t) in[3] << 24;
+}
+
+bool replayStartRecording(const char *fileName, uint64_t seed) {
+    replay.file = fopen(fileName, "wb");
+    if (!replay.file) {
+        printf("[ERROR] Failed to create replay %s\n", fileName);
+        return false;
+    }
+    replay.mode = REPLAY_RECORD;
+    replay.seed = seed;
+    return true;
+}
+
+bool replayStartPlayback(const char *fileName, uint64_t *seed) {
+    FILE *file = fopen(fileName, "rb");
+    if (!file) {
+        printf("[ERROR] Failed to open replay %s\n", fileName);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < REPLAY_HEADER_SIZE) {
+        printf("[ERROR] %s is not a replay\n", fileName);
+        fclose(file);
+        return false;
+    }
+
+    replay.data = malloc((size_t) size);
+    if (!replay.data || fread(replay.data, 1, (size_t) size, file) != (size_t) size) {
+        printf("[ERROR] Failed to read replay %s\n", fileName);
+        free(replay.data);
+        replay.data = NULL;
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    if (memcmp(replay.data, REPLAY_MAGIC, 4) != 0) {
+        printf("[ERROR] %s is not a replay\n", fileName);
+        free(replay.data);
+        replay.data = NULL;
+        return false;
+    }
+
+    replay.seed = getU32(replay.data + 4) | (uint64_t) getU32(replay.data + 8) << 32;
+    replay.size = (size_t) size;
+    replay.pos = REPLAY_HEADER_SIZE;
+    replay.mode = REPLAY_PLAY;
+    *seed = replay.seed;
+    return true;
+}
+
+ReplayMode replayGetMode(void) {
+    return replay.mode;
+}
+
+bool replayBegin(SDL_Window *window) {
+    replay.window = window;
+
+    if (replay.mode == REPLAY_RECORD) {
+        int w, h;
+        SDL_GetWindowSize(window, &w, &h);
+
+        uint8_t header[REPLAY_HEADER_SIZE + 2 * 10];
+        memcpy(header, REPLAY_MAGIC, 4);
+        putU32(header + 4, (uint32_t) replay.seed);
+        putU32(header + 8, (uint32_t) (replay.seed >> 32));
+        size_t n = REPLAY_HEADER_SIZE;
+        n += putVarint(header + n, (uint64_t) w);
+        n += putVarint(header + n, (uint64_t) h);
+        if (fwrite(header, 1, n, replay.file) != n) {
+            printf("[ERROR] Failed to write replay header\n");
+            return false;
+        }
+    } else if (replay.mode == REPLAY_PLAY) {
+        int w = (int) getVarint();
+        int h = (int) getVarint();
+        if (replay.finished || w <= 0 || h <= 0) {
+            printf("[ERROR] Replay header is damaged\n");
+            return false;
+        }
+        SDL_SetWindowSize(window, w, h);
+
+        replay.startCounter = SDL_GetPerformanceCounter();
+        replay.frameCounter = replay.startCounter;
+    }
+    return true;
+}
+
+/**
+ * Encodes the parts of an event the screens look at
+ *
+ * @return bytes written to out, 0 for events that aren't recorded
+ */
+static size_t encodeEvent(const SDL_Event *event, uint8_t *out) {
+    size_t n = 0;
+    switch (event->type) {
+        case SDL_QUIT:
+            n += putVarint(out, TAG_QUIT);
+            break;
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            n += putVarint(out, event->type == SDL_KEYDOWN ? TAG_KEY_DOWN : TAG_KEY_UP);
+            n += putVarint(out + n, (uint64_t) event->key.keysym.scancode);
+            n += putSigned(out + n, event->key.keysym.sym);
+            n += putVarint(out + n, event->key.keysym.mod);
+            n += putVarint(out + n, event->key.repeat);
+            break;
+        case SDL_MOUSEMOTION:
+            n += putVarint(out, TAG_MOUSE_MOTION);
+            n += putVarint(out + n, event->motion.state);
+            n += putSigned(out + n, event->motion.x);
+            n += putSigned(out + n, event->motion.y);
+            n += putSigned(out + n, event->motion.xrel);
+            n += putSigned(out + n, event->motion.yrel);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            n += putVarint(out, event->type == SDL_MOUSEBUTTONDOWN ? TAG_MOUSE_DOWN : TAG_MOUSE_UP);
+            n += putVarint(out + n, event->button.button);
+            n += putVarint(out + n, event->button.clicks);
+            n += putSigned(out + n, event->button.x);
+            n += putSigned(out + n, event->button.y);
+            break;
+        case SDL_WINDOWEVENT:
+            n += putVarint(out, TAG_WINDOW);
+            n += putVarint(out + n, event->window.event);
+            n += putSigned(out + n, event->window.data1);
+            n += putSigned(out + n, event->window.data2);
+            break;
+        default:
+            break;
+    }
+    return n;
+}
+
+/**
+ * Decodes the next event of the current frame from the log
+ *
+ * @return false at the end of the frame or the log
+ */
+static bool decodeEvent(SDL_Event *event) {
+    uint64_t tag = getVarint();
+    if (replay.finished) return false;
+
+    memset(event, 0, sizeof(SDL_Event));
+    Uint32 windowID = SDL_GetWindowID(replay.window);
+    switch (tag) {
+        case TAG_FRAME_END:
+            replay.frameTime = (float) getVarint() / 1000000.0f;
+            replay.frameEnded = true;
+            return false;
+        case TAG_QUIT:
+            event->type = SDL_QUIT;
+            break;
+        case TAG_KEY_DOWN:
+        case TAG_KEY_UP:
+            event->type = tag == TAG_KEY_DOWN ? SDL_KEYDOWN : SDL_KEYUP;
+            event->key.windowID = windowID;
+            event->key.state = tag == TAG_KEY_DOWN;
+            event->key.keysym.scancode = (int) getVarint();
+            event->key.keysym.sym = (SDL_Keycode) getSigned();
+            event->key.keysym.mod = (Uint16) getVarint();
+            event->key.repeat = (Uint8) getVarint();
+            break;
+        case TAG_MOUSE_MOTION:
+            event->type = SDL_MOUSEMOTION;
+            event->motion.windowID = windowID;
+            event->motion.state = (Uint32) getVarint();
+            event->motion.x = (Sint32) getSigned();
+            event->motion.y = (Sint32) getSigned();
+            event->motion.xrel = (Sint32) getSigned();
+            event->motion.yrel = (Sint32) getSigned();
+            break;
+        case TAG_MOUSE_DOWN:
+        case TAG_MOUSE_UP:
+            event->type = tag == TAG_MOUSE_DOWN ? SDL_MOUSEBUTTONDOWN : SDL_MOUSEBUTTONUP;
+            event->button.windowID = windowID;
+            event->button.state = tag == TAG_MOUSE_DOWN;
+            event->button.button = (Uint8) getVarint();
+            event->button.clicks = (Uint8) getVarint();
+            event->button.x = (Sint32) getSigned();
+            event->button.y = (Sint32) getSigned();
+            break;
+        case TAG_WINDOW:
+            event->type = SDL_WINDOWEVENT;
+            event->window.windowID = windowID;
+            event->window.event = (Uint8) getVarint();
+            event->window.data1 = (Sint32) getSigned();
+            event->window.data2 = (Sint32) getSigned();
+
+            //the offscreen window has to follow the recorded one, the screens read its size
+            if (event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                SDL_SetWindowSize(replay.window, event->window.data1, event->window.data2);
+            }
+            break;
+        default:
+            printf("[ERROR] Unknown replay record %d, stopping playback\n", (int) tag);
+            replay.finished = true;
+            return false;
+    }
+    event->common.timestamp = SDL_GetTicks();
+    return !replay.finished;
+}
+
+bool replayPollEvent(SDL_Event *event) {
+    if (replay.mode != REPLAY_PLAY) {
+        if (!SDL_PollEvent(event)) return false;
+
+        if (replay.mode == REPLAY_RECORD) {
+            uint8_t record[MAX_RECORD_BYTES];
+            size_t n = encodeEvent(event, record);
+            if (n) fwrite(record, 1, n, replay.file);
+        }
+        return true;
+    }
+
+    //the real queue only holds what the offscreen window generates itself, the log replaces it
+    SDL_Event ignored;
+    while (SDL_PollEvent(&ignored)) {}
+
+    if (replay.frameEnded || replay.finished) return false;
+    return decodeEvent(event);
+}
+
+float replayFrameTime(float measured) {
+    if (replay.mode == REPLAY_RECORD) {
+        //stored in whole microseconds, use the rounded value here too so playback sees the same numbers
+        uint32_t micros = (uint32_t) (measured * 1000000.0f + 0.5f);
+        uint8_t record[MAX_RECORD_BYTES];
+        size_t n = putVarint(record, TAG_FRAME_END);
+        n += putVarint(record + n, micros);
+        fwrite(record, 1, n, replay.file);
+        return (float) micros / 1000000.0f;
+    }
+
+    if (replay.mode == REPLAY_PLAY) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        double frame = (double) (now - replay.frameCounter) / SDL_GetPerformanceFrequency();
+        if (replay.frames > 0 && frame > replay.slowestFrame) replay.slowestFrame = frame;
+        replay.frameCounter = now;
+        replay.frames++;
+
+        replay.frameEnded = false;
+        return replay.frameTime;
+    }
+
+    return measured;
+}
+
+bool replayFinished(void) {
+    return replay.mode == REPLAY_PLAY && replay.finished;
+}
+
+void replayStop(void) {
+    if (replay.mode == REPLAY_RECORD && replay.file) {
+        if (fclose(replay.file) != 0) {
+            printf("[ERROR] Failed to finish writing the replay\n");
+        }
+        replay.file = NULL;
+    } else if (replay.mode == REPLAY_PLAY) {
+        double total = (double) (SDL_GetPerformanceCounter() - replay.startCounter) / SDL_GetPerformanceFrequency();
+        printf("Replayed %d frames in %.3f s, %.3f ms per frame, slowest %.3f ms\n",
+               replay.frames, total, replay.frames ? total * 1000.0 / replay.frames : 0.0,
+               replay.slowestFrame * 1000.0);
+        free(replay.data);
+        replay.data = NULL;
+    }
+    replay.mode = REPLAY_OFF;
+}
@@ -0,0 +1,44 @@
+#ifndef HANGMAN_REPLAY_H
+#define HANGMAN_REPLAY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Records a play session into a compact binary log and plays it back. The log starts with the rng seed and
+ * window size, followed by every frame: the input events polled in it and the frame time it measured.
+ * Played back with the same seed, word lists and textures, the game goes through exactly the same states,
+ * so a recorded session doubles as a repeatable rendering benchmark
+ */
+
+typedef enum {
+    REPLAY_OFF,
+    REPLAY_RECORD,
+    REPLAY_PLAY
+} ReplayMode;
+
+// opens the log for writing, the header is written by replayBegin
+bool replayStartRecording(const char *fileName, uint64_t seed);
+
+// reads the whole log into memory, the seed to start the game with is written to seed
+bool replayStartPlayback(const char *fileName, uint64_t *seed);
+
+ReplayMode replayGetMode(void);
+
+// call right before the first frame. Records the window size, or restores the recorded one on playback
+bool replayBegin(SDL_Window *window);
+
+// drop in for SDL_PollEvent. Recorded events are written to the log, played back ones come from it
+bool replayPollEvent(SDL_Event *event);
+
+// frame time of the current frame, measured while recording and taken from the log on playback
+float replayFrameTime(float measured);
+
+// true once playback ran out of frames
+bool replayFinished(void);
+
+// flushes and closes the log, prints timings after a playback
+void replayStop(void);
+
+#endif
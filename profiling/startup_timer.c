@@ -0,0 +1,49 @@
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "startup_timer.h"
+
+static const char *phaseNames[STARTUP_PHASES] = {
+    "SDL_Init",
+    "TTF_Init",
+    "window and renderer",
+    "word lists",
+    "loading screen init",
+    "surface load",
+    "texture upload",
+    "menu init",
+    "first menu frame"
+};
+
+static Uint64 startCounter;
+static Uint64 lastCounter;
+static Uint64 phaseTicks[STARTUP_PHASES];
+static bool phaseMarked[STARTUP_PHASES];
+
+void startupTimerBegin(void) {
+    startCounter = SDL_GetPerformanceCounter();
+    lastCounter = startCounter;
+}
+
+void startupTimerMark(StartupPhase phase) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    phaseTicks[phase] += now - lastCounter;
+    phaseMarked[phase] = true;
+    lastCounter = now;
+}
+
+void startupTimerReport(void) {
+    double frequency = (double) SDL_GetPerformanceFrequency();
+    double total = (lastCounter - startCounter) * 1000.0 / frequency;
+    double elapsed = 0;
+
+    printf("%-22s %10s %7s %10s\n", "phase", "ms", "share", "at ms");
+    for (int i = 0; i < STARTUP_PHASES; i++) {
+        if (!phaseMarked[i]) continue;
+        double ms = phaseTicks[i] * 1000.0 / frequency;
+        elapsed += ms;
+        printf("%-22s %10.3f %6.1f%% %10.3f\n", phaseNames[i], ms, total > 0 ? ms * 100.0 / total : 0.0, elapsed);
+    }
+    printf("%-22s %10.3f\n", "total", total);
+}
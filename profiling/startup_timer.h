@@ -0,0 +1,29 @@
+#ifndef HANGMAN_STARTUP_TIMER_H
+#define HANGMAN_STARTUP_TIMER_H
+
+/*
+ * Splits startup into phases on the monotonic performance counter. Each mark ends the phase with that name,
+ * which started where the previous mark left off, so the phases add up to the whole startup
+ */
+
+typedef enum {
+    STARTUP_SDL_INIT,
+    STARTUP_TTF_INIT,
+    STARTUP_WINDOW,
+    STARTUP_WORD_LISTS,
+    STARTUP_LOADING_SCREEN,
+    STARTUP_SURFACE_LOAD,
+    STARTUP_TEXTURE_UPLOAD,
+    STARTUP_MENU_INIT,
+    STARTUP_FIRST_FRAME,
+    STARTUP_PHASES
+} StartupPhase;
+
+void startupTimerBegin(void);
+
+void startupTimerMark(StartupPhase phase);
+
+// prints every phase that was marked with its share of the total
+void startupTimerReport(void);
+
+#endif
@@ -7,15 +7,38 @@
 #include <string.h>
 
 #include "graphics/texture_manager.h"
+#include "graphics/font_manager.h"
+#include "../profiling/alloc_tracker.h"
+
+#define RESIZE_DEBOUNCE_MS 150
+
+//wrapped lines rasterized into surfaces, produced off the main thread
+typedef struct {
+    SDL_Surface **surfaces;
+    int numLines;
+    int winW, winH;
+} AboutLayout;
 
 typedef struct {
-    TTF_Font *font;
     char *rawText;
     SDL_Texture **lines;
     int *lineWidths;
     int *lineHeights;
     int numLines;
     int winW, winH;
+
+    //window size the current textures were laid out for
+    int layoutW, layoutH;
+
+    //resize debounce, layout is only requested once the size stops changing
+    bool resizePending;
+    int pendingW, pendingH;
+    Uint32 resizeTime;
+
+    //background layout job
+    SDL_Thread *layoutThread;
+    SDL_atomic_t layoutDone;
+    AboutLayout job;
 } AboutSection;
 
 static AboutSection about;
@@ -56,25 +79,39 @@ static char *loadTextFile(const char *path) {
     return buffer;
 }
 
-//render text into textures (handles empty lines and resizing)
-static void renderTextures(SDL_Renderer *renderer) {
-    // Free old textures if they exist
-    if (about.lines) {
-        for (int i = 0; i < about.numLines; i++) {
-            if (about.lines[i]) {
-                SDL_DestroyTexture(about.lines[i]);
-            }
+static int fontSizeForHeight(int winH) {
+    int fontSize = winH / 20; //scale factor
+    if (fontSize < 12) fontSize = 12; //minimum readable size
+    return fontSize;
+}
+
+static void freeLayout(AboutLayout *layout) {
+    if (layout->surfaces) {
+        for (int i = 0; i < layout->numLines; i++) {
+            if (layout->surfaces[i]) SDL_FreeSurface(layout->surfaces[i]);
         }
-        free(about.lines);
-        free(about.lineWidths);
-        free(about.lineHeights);
+        free(layout->surfaces);
     }
+    memset(layout, 0, sizeof(AboutLayout));
+}
 
-    if (!about.rawText) return;
+//wrap and rasterize text into surfaces (handles empty lines), safe to run off the main thread
+static void layoutText(const char *rawText, AboutLayout *out) {
+    out->surfaces = NULL;
+    out->numLines = 0;
+    if (!rawText) return;
+
+    //every layout opens its own font so the worker never shares one with the main thread, only the file bytes.
+    //FreeType is still shared, so each TTF call holds the font manager lock and the renderer waits at most a line
+    TTF_Font *font = fontManagerOpen(FONT_PIXELIFY_SEMIBOLD, fontSizeForHeight(out->winH));
+    if (!font) {
+        printf("ERROR: Could not resize font!\n");
+        return;
+    }
 
     //count lines by manually scanning for newlines
     int lineCount = 0;
-    char *p = about.rawText;
+    const char *p = rawText;
 
     //handle empty string case
     if (*p == '\0') {
@@ -89,31 +126,30 @@ static void renderTextures(SDL_Renderer *renderer) {
         }
     }
 
-    //allocate arrays
-    about.numLines = lineCount;
-    about.lines = malloc(sizeof(SDL_Texture *) * lineCount);
-    about.lineWidths = malloc(sizeof(int) * lineCount);
-    about.lineHeights = malloc(sizeof(int) * lineCount);
+    out->numLines = lineCount;
+    out->surfaces = calloc(lineCount > 0 ? lineCount : 1, sizeof(SDL_Surface *));
 
     //render each line
     SDL_Color white = {255, 255, 255, 255};
-    int wrapWidth = about.winW - 100; // 50px margin each side
-    int fontHeight = TTF_FontHeight(about.font);
+    int wrapWidth = out->winW - 100; // 50px margin each side
+    fontManagerLock();
+    int fontHeight = TTF_FontHeight(font);
+    fontManagerUnlock();
 
-    char *lineStart = about.rawText;
+    const char *lineStart = rawText;
     int idx = 0;
 
-    for (char *p = about.rawText; ; p++) {
+    for (const char *c = rawText; idx < lineCount; c++) {
         //check if we've reached end of line or end of string
-        if (*p == '\n' || *p == '\0') {
+        if (*c == '\n' || *c == '\0') {
             //calculate line length
-            int lineLen = p - lineStart;
+            int lineLen = c - lineStart;
 
             SDL_Surface *surf = NULL;
             if (lineLen == 0) {
                 //empty line, create small surface for spacing
                 surf = SDL_CreateRGBSurface(0, 1, fontHeight, 32, 0, 0, 0, 0);
-                SDL_FillRect(surf, NULL, SDL_MapRGBA(surf->format, 0, 0, 0, 0));
+                if (surf) SDL_FillRect(surf, NULL, SDL_MapRGBA(surf->format, 0, 0, 0, 0));
             } else {
                 //create a null terminated copy of the line
                 char *lineCopy = malloc(lineLen + 1);
@@ -121,30 +157,101 @@ static void renderTextures(SDL_Renderer *renderer) {
                 lineCopy[lineLen] = '\0';
 
                 //render wrapped text
-                surf = TTF_RenderText_Blended_Wrapped(about.font, lineCopy, white, wrapWidth);
+                fontManagerLock();
+                surf = TTF_RenderText_Blended_Wrapped(font, lineCopy, white, wrapWidth);
+                fontManagerUnlock();
                 free(lineCopy);
             }
+            out->surfaces[idx++] = surf;
 
-            if (surf) {
-                about.lines[idx] = SDL_CreateTextureFromSurface(renderer, surf);
-                about.lineWidths[idx] = surf->w;
-                about.lineHeights[idx] = surf->h;
-                SDL_FreeSurface(surf);
-            } else {
-                about.lines[idx] = NULL;
-                about.lineWidths[idx] = 0;
-                about.lineHeights[idx] = fontHeight;
-            }
+            //if we reach end of string, break
+            if (*c == '\0') break;
 
-            idx++;
+            //move to the start of next line
+            lineStart = c + 1;
+        }
+    }
 
-            //ff we reach end of string, break
-            if (*p == '\0') break;
+    fontManagerClose(font);
+}
 
-            //move to the start of next line
-            lineStart = p + 1;
+static int layoutThreadMain(void *data) {
+    layoutText(about.rawText, &about.job);
+    SDL_AtomicSet(&about.layoutDone, 1);
+    return 0;
+}
+
+static void freeTextures(void) {
+    if (about.lines) {
+        for (int i = 0; i < about.numLines; i++) {
+            if (about.lines[i]) SDL_DestroyTexture(about.lines[i]);
+        }
+        free(about.lines);
+    }
+    if (about.lineWidths) free(about.lineWidths);
+    if (about.lineHeights) free(about.lineHeights);
+    about.lines = NULL;
+    about.lineWidths = NULL;
+    about.lineHeights = NULL;
+    about.numLines = 0;
+}
+
+//upload a finished layout into textures, the only part that has to happen on the main thread
+static void uploadLayout(SDL_Renderer *renderer, AboutLayout *layout) {
+    freeTextures();
+
+    int count = layout->numLines;
+    about.numLines = count;
+    about.lines = calloc(count > 0 ? count : 1, sizeof(SDL_Texture *));
+    about.lineWidths = calloc(count > 0 ? count : 1, sizeof(int));
+    about.lineHeights = calloc(count > 0 ? count : 1, sizeof(int));
+
+    for (int i = 0; i < count; i++) {
+        SDL_Surface *surf = layout->surfaces[i];
+        if (surf) {
+            about.lines[i] = SDL_CreateTextureFromSurface(renderer, surf);
+            about.lineWidths[i] = surf->w;
+            about.lineHeights[i] = surf->h;
+        } else {
+            about.lineHeights[i] = fontSizeForHeight(layout->winH);
         }
     }
+
+    about.layoutW = layout->winW;
+    about.layoutH = layout->winH;
+    freeLayout(layout);
+}
+
+static void startLayoutJob(int winW, int winH) {
+    freeLayout(&about.job);
+    about.job.winW = winW;
+    about.job.winH = winH;
+    SDL_AtomicSet(&about.layoutDone, 0);
+
+    about.layoutThread = SDL_CreateThread(layoutThreadMain, "AboutLayout", NULL);
+    if (!about.layoutThread) {
+        //fall back to laying out on this thread
+        printf("[WARNING] Failed to create about layout thread: %s\n", SDL_GetError());
+        layoutText(about.rawText, &about.job);
+        SDL_AtomicSet(&about.layoutDone, 1);
+    }
+}
+
+//picks up a finished background layout, returns true if new textures were uploaded
+static bool collectLayoutJob(SDL_Renderer *renderer) {
+    if (!SDL_AtomicGet(&about.layoutDone)) return false;
+
+    if (about.layoutThread) {
+        SDL_WaitThread(about.layoutThread, NULL);
+        about.layoutThread = NULL;
+    }
+    SDL_AtomicSet(&about.layoutDone, 0);
+    uploadLayout(renderer, &about.job);
+    return true;
+}
+
+static bool layoutJobRunning(void) {
+    return about.layoutThread != NULL && !SDL_AtomicGet(&about.layoutDone);
 }
 
 //initialise about section
@@ -154,64 +261,54 @@ bool aboutSectionInit(SDL_Window *window, SDL_Renderer *renderer) {
 
     SDL_GetWindowSize(window, &about.winW, &about.winH);
 
-    about.font = TTF_OpenFont("resources/font/PixelifySans-SemiBold.ttf", 36);
-    if (!about.font) return false;
-
     about.rawText = loadTextFile("resources/textures/about_section/about.txt");
     if (!about.rawText) return false;
 
-    renderTextures(renderer); // initial rendering
+    //initial layout happens synchronously so the first frame has text
+    about.job.winW = about.winW;
+    about.job.winH = about.winH;
+    layoutText(about.rawText, &about.job);
+    uploadLayout(renderer, &about.job);
     return true;
 }
 
 //destroy about section
 void aboutSectionDestroy() {
-    if (about.lines) {
-        for (int i = 0; i < about.numLines; i++) {
-            if (about.lines[i]) SDL_DestroyTexture(about.lines[i]);
-        }
-        free(about.lines);
+    if (about.layoutThread) {
+        SDL_WaitThread(about.layoutThread, NULL);
+        about.layoutThread = NULL;
     }
-    if (about.lineWidths) free(about.lineWidths);
-    if (about.lineHeights) free(about.lineHeights);
+    freeLayout(&about.job);
+    freeTextures();
     if (about.rawText) free(about.rawText);
-    if (about.font) TTF_CloseFont(about.font);
 
     TTF_Quit();
     IMG_Quit();
 }
 
 //render about section
-void aboutSectionRender(SDL_Renderer *renderer, SDL_Window *window) {
-    static int prevW = 0, prevH = 0;
-    static int prevFontSize = 0;
-
-    SDL_GetWindowSize(window, &about.winW, &about.winH);
-
-    //determine new font size based on height
-    int newFontSize = about.winH / 20; //scale factor
-    if (newFontSize < 12) newFontSize = 12; //minimum readable size
-
-    bool sizeChanged = (about.winW != prevW || about.winH != prevH);
-    bool fontChanged = (newFontSize != prevFontSize);
-
-    //if window size changed or font size changed, rebuild fonts/textures
-    if (sizeChanged || fontChanged) {
-        prevW = about.winW;
-        prevH = about.winH;
-        prevFontSize = newFontSize;
+void aboutSectionRender(SDL_Renderer *renderer, int winW, int winH) {
+    about.winW = winW;
+    about.winH = winH;
+
+    collectLayoutJob(renderer);
+
+    //restart the debounce timer on every size change, so live drags don't queue a layout per step
+    bool pendingStale = about.resizePending && (about.winW != about.pendingW || about.winH != about.pendingH);
+    bool layoutStale = !about.resizePending && (about.winW != about.layoutW || about.winH != about.layoutH);
+    if (pendingStale || layoutStale) {
+        about.resizePending = true;
+        about.pendingW = about.winW;
+        about.pendingH = about.winH;
+        about.resizeTime = SDL_GetTicks();
+    }
 
-        //reopen font at new size
-        if (about.font) {
-            TTF_CloseFont(about.font);
+    if (about.resizePending && !layoutJobRunning() &&
+        SDL_GetTicks() - about.resizeTime >= RESIZE_DEBOUNCE_MS) {
+        about.resizePending = false;
+        if (about.pendingW != about.layoutW || about.pendingH != about.layoutH) {
+            startLayoutJob(about.pendingW, about.pendingH);
         }
-        about.font = TTF_OpenFont("resources/font/PixelifySans-SemiBold.ttf", newFontSize);
-        if (!about.font) {
-            printf("ERROR: Could not resize font!\n");
-        }
-
-        //rerender wrapped text
-        renderTextures(renderer);
     }
 
     //draw everything
@@ -220,19 +317,21 @@ void aboutSectionRender(SDL_Renderer *renderer, SDL_Window *window) {
     SDL_Rect fullWin = {0, 0, about.winW, about.winH};
     SDL_RenderCopy(renderer, g_aboutTextures.background, NULL, &fullWin);
 
+    //until the new layout arrives, the previous one is scaled to the current height
+    float scale = about.layoutH > 0 ? about.winH / (float) about.layoutH : 1.0f;
+
     int y = (int) (about.winH * 0.3);
 
     for (int i = 0; i < about.numLines; i++) {
+        int lineH = (int) (about.lineHeights[i] * scale);
         if (about.lines[i]) {
             SDL_Rect r;
-            r.w = about.lineWidths[i];
-            r.h = about.lineHeights[i];
+            r.w = (int) (about.lineWidths[i] * scale);
+            r.h = lineH;
             r.x = (about.winW - r.w) / 2;
             r.y = y;
             SDL_RenderCopy(renderer, about.lines[i], NULL, &r);
         }
-        y += about.lineHeights[i] + 5;
+        y += lineH + 5;
     }
-
-    SDL_RenderPresent(renderer);
 }
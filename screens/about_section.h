@@ -8,6 +8,7 @@ bool aboutSectionInit(SDL_Window *window, SDL_Renderer *renderer);
 
 void aboutSectionDestroy();
 
-void aboutSectionRender(SDL_Renderer *renderer, SDL_Window *window);
+//draws the section, the caller presents the frame
+void aboutSectionRender(SDL_Renderer *renderer, int winW, int winH);
 
 #endif
@@ -0,0 +1,209 @@
+#include "bitmap_font.h"
+#include "font_manager.h"
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../profiling/alloc_tracker.h"
+
+#define ATLAS_WIDTH 512
+#define ATLAS_PADDING 1
+#define BATCH_GLYPHS 256
+
+//shared vertex/index scratch space, rendering only ever happens on one thread
+static SDL_Vertex g_vertices[BATCH_GLYPHS * 4];
+static int g_indices[BATCH_GLYPHS * 6];
+static bool g_indicesReady = false;
+
+static const BitmapGlyph *lookupGlyph(const BitmapFont *font, char c) {
+    unsigned char uc = (unsigned char) c;
+    if (uc < BITMAP_FONT_FIRST_CHAR || uc > BITMAP_FONT_LAST_CHAR) uc = '?';
+    return &font->glyphs[uc - BITMAP_FONT_FIRST_CHAR];
+}
+
+bool bitmapFontLoad(BitmapFont *font, SDL_Renderer *renderer, const char *path, int pixelSize) {
+    memset(font, 0, sizeof(BitmapFont));
+
+    TTF_Font *ttf = fontManagerGet(path, pixelSize);
+    if (!ttf) {
+        printf("[ERROR] Failed to open font %s for atlas: %s\n", path, TTF_GetError());
+        return false;
+    }
+    fontManagerLock();
+    font->lineHeight = TTF_FontHeight(ttf);
+
+    //rasterize every glyph separately, each one positioned exactly like it would be at the start of a string
+    SDL_Surface *glyphSurfs[BITMAP_FONT_GLYPH_COUNT] = {0};
+    SDL_Color white = {255, 255, 255, 255};
+    int penX = 0, penY = 0, rowH = 0;
+
+    for (int i = 0; i < BITMAP_FONT_GLYPH_COUNT; i++) {
+        char str[2] = {(char) (BITMAP_FONT_FIRST_CHAR + i), '\0'};
+        BitmapGlyph *glyph = &font->glyphs[i];
+
+        int minx, maxx, miny, maxy, advance;
+        if (TTF_GlyphMetrics(ttf, (Uint16) str[0], &minx, &maxx, &miny, &maxy, &advance) == 0) {
+            glyph->advance = advance;
+        }
+
+        //space and other blank glyphs only need their advance
+        if (str[0] == ' ') continue;
+        glyphSurfs[i] = TTF_RenderText_Blended(ttf, str, white);
+        if (!glyphSurfs[i]) continue;
+
+        int w = glyphSurfs[i]->w;
+        int h = glyphSurfs[i]->h;
+        if (penX + w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowH + ATLAS_PADDING;
+            rowH = 0;
+        }
+        glyph->src.x = penX;
+        glyph->src.y = penY;
+        glyph->src.w = w;
+        glyph->src.h = h;
+        penX += w + ATLAS_PADDING;
+        if (h > rowH) rowH = h;
+    }
+    fontManagerUnlock();
+
+    //pack glyphs into one atlas surface, copying alpha as is
+    int atlasH = penY + rowH;
+    if (atlasH <= 0) atlasH = 1;
+    SDL_Surface *atlasSurf = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, atlasH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurf) {
+        SDL_FillRect(atlasSurf, NULL, SDL_MapRGBA(atlasSurf->format, 255, 255, 255, 0));
+        for (int i = 0; i < BITMAP_FONT_GLYPH_COUNT; i++) {
+            if (!glyphSurfs[i]) continue;
+            SDL_Rect dst = font->glyphs[i].src;
+            SDL_SetSurfaceBlendMode(glyphSurfs[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyphSurfs[i], NULL, atlasSurf, &dst);
+        }
+    }
+    for (int i = 0; i < BITMAP_FONT_GLYPH_COUNT; i++) {
+        if (glyphSurfs[i]) SDL_FreeSurface(glyphSurfs[i]);
+    }
+    if (!atlasSurf) {
+        printf("[ERROR] Failed to create font atlas surface: %s\n", SDL_GetError());
+        return false;
+    }
+
+    font->atlas = SDL_CreateTextureFromSurface(renderer, atlasSurf);
+    SDL_FreeSurface(atlasSurf);
+    if (!font->atlas) {
+        printf("[ERROR] Failed to create font atlas texture: %s\n", SDL_GetError());
+        return false;
+    }
+
+    //pixel fonts must stay crisp when scaled
+    SDL_SetTextureBlendMode(font->atlas, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(font->atlas, SDL_ScaleModeNearest);
+
+    return true;
+}
+
+void bitmapFontDestroy(BitmapFont *font) {
+    if (font->atlas) SDL_DestroyTexture(font->atlas);
+    memset(font, 0, sizeof(BitmapFont));
+}
+
+bool bitmapFontIsLoaded(const BitmapFont *font) {
+    return font->atlas != NULL;
+}
+
+void bitmapFontMeasure(const BitmapFont *font, const char *text, int *outW, int *outH) {
+    int lineW = 0, maxW = 0, lines = 1;
+    for (const char *p = text; *p; p++) {
+        if (*p == '\n') {
+            if (lineW > maxW) maxW = lineW;
+            lineW = 0;
+            lines++;
+            continue;
+        }
+        lineW += lookupGlyph(font, *p)->advance;
+    }
+    if (lineW > maxW) maxW = lineW;
+
+    if (outW) *outW = maxW;
+    if (outH) *outH = lines * font->lineHeight;
+}
+
+static void flushBatch(SDL_Renderer *renderer, const BitmapFont *font, int glyphCount) {
+    if (glyphCount > 0) {
+        SDL_RenderGeometry(renderer, font->atlas, g_vertices, glyphCount * 4, g_indices, glyphCount * 6);
+    }
+}
+
+//appends one quad per visible glyph, flushing whenever the scratch buffer fills up
+static int appendText(SDL_Renderer *renderer, const BitmapFont *font, const char *text, int x, int y,
+                      SDL_Color color, int glyphCount) {
+    float invW = 1.0f / ATLAS_WIDTH;
+    int atlasH;
+    SDL_QueryTexture(font->atlas, NULL, NULL, NULL, &atlasH);
+    float invH = 1.0f / atlasH;
+
+    int penX = x, penY = y;
+    for (const char *p = text; *p; p++) {
+        if (*p == '\n') {
+            penX = x;
+            penY += font->lineHeight;
+            continue;
+        }
+
+        const BitmapGlyph *glyph = lookupGlyph(font, *p);
+        if (glyph->src.w > 0) {
+            if (glyphCount == BATCH_GLYPHS) {
+                flushBatch(renderer, font, glyphCount);
+                glyphCount = 0;
+            }
+
+            float x0 = (float) penX, y0 = (float) penY;
+            float x1 = x0 + glyph->src.w, y1 = y0 + glyph->src.h;
+            float u0 = glyph->src.x * invW, v0 = glyph->src.y * invH;
+            float u1 = (glyph->src.x + glyph->src.w) * invW, v1 = (glyph->src.y + glyph->src.h) * invH;
+
+            SDL_Vertex *v = &g_vertices[glyphCount * 4];
+            v[0] = (SDL_Vertex) {{x0, y0}, color, {u0, v0}};
+            v[1] = (SDL_Vertex) {{x1, y0}, color, {u1, v0}};
+            v[2] = (SDL_Vertex) {{x1, y1}, color, {u1, v1}};
+            v[3] = (SDL_Vertex) {{x0, y1}, color, {u0, v1}};
+            glyphCount++;
+        }
+        penX += glyph->advance;
+    }
+    return glyphCount;
+}
+
+static void prepareIndices(void) {
+    if (g_indicesReady) return;
+    for (int i = 0; i < BATCH_GLYPHS; i++) {
+        int *idx = &g_indices[i * 6];
+        idx[0] = i * 4;
+        idx[1] = i * 4 + 1;
+        idx[2] = i * 4 + 2;
+        idx[3] = i * 4;
+        idx[4] = i * 4 + 2;
+        idx[5] = i * 4 + 3;
+    }
+    g_indicesReady = true;
+}
+
+void bitmapFontDraw(SDL_Renderer *renderer, const BitmapFont *font, const char *text, int x, int y,
+                    SDL_Color color) {
+    if (!text || !font->atlas) return;
+    prepareIndices();
+    int count = appendText(renderer, font, text, x, y, color, 0);
+    flushBatch(renderer, font, count);
+}
+
+void bitmapFontDrawWithShadow(SDL_Renderer *renderer, const BitmapFont *font, const char *text, int x, int y,
+                              SDL_Color color) {
+    if (!text || !font->atlas) return;
+    prepareIndices();
+
+    //shadow and fill go out in the same batch, shadow quads first so the fill lands on top
+    SDL_Color shadowColor = {0, 0, 0, color.a};
+    int count = appendText(renderer, font, text, x + 2, y + 2, shadowColor, 0);
+    count = appendText(renderer, font, text, x, y, color, count);
+    flushBatch(renderer, font, count);
+}
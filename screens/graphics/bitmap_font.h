@@ -0,0 +1,40 @@
+#ifndef BITMAP_FONT_H
+#define BITMAP_FONT_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+//printable ascii range baked into the atlas
+#define BITMAP_FONT_FIRST_CHAR 32
+#define BITMAP_FONT_LAST_CHAR 126
+#define BITMAP_FONT_GLYPH_COUNT (BITMAP_FONT_LAST_CHAR - BITMAP_FONT_FIRST_CHAR + 1)
+
+typedef struct {
+    SDL_Rect src; //location inside the atlas texture
+    int advance;  //pen advance after drawing this glyph
+} BitmapGlyph;
+
+typedef struct {
+    SDL_Texture *atlas;
+    BitmapGlyph glyphs[BITMAP_FONT_GLYPH_COUNT];
+    int lineHeight;
+} BitmapFont;
+
+//rasterizes every printable glyph of the font once and packs them into a single texture
+bool bitmapFontLoad(BitmapFont *font, SDL_Renderer *renderer, const char *path, int pixelSize);
+
+void bitmapFontDestroy(BitmapFont *font);
+
+bool bitmapFontIsLoaded(const BitmapFont *font);
+
+void bitmapFontMeasure(const BitmapFont *font, const char *text, int *outW, int *outH);
+
+//draws the string as one batch of textured quads, newlines start a new line
+void bitmapFontDraw(SDL_Renderer *renderer, const BitmapFont *font, const char *text, int x, int y,
+                    SDL_Color color);
+
+//same as bitmapFontDraw, with a black copy offset by 2px drawn first
+void bitmapFontDrawWithShadow(SDL_Renderer *renderer, const BitmapFont *font, const char *text, int x, int y,
+                              SDL_Color color);
+
+#endif
@@ -0,0 +1,166 @@
+#include "font_manager.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../profiling/alloc_tracker.h"
+
+#define MAX_FONT_FILES 8
+#define MAX_FONT_PATH 128
+#define MAX_OPEN_FONTS 128
+
+typedef struct {
+    char path[MAX_FONT_PATH];
+    void *bytes;   //NULL if the file couldn't be read, the fallback is used instead
+    size_t size;
+} FontFile;
+
+typedef struct {
+    const FontFile *file;
+    int size;
+    TTF_Font *font;
+} OpenFont;
+
+//files are appended under the lock and never removed before fontManagerDestroy, so entries can be read without it
+static FontFile g_files[MAX_FONT_FILES];
+static SDL_atomic_t g_fileCount;
+static SDL_SpinLock g_filesLock = 0;
+
+//serialises SDL_ttf, created on first use so fonts can be preloaded before anything else is set up
+static SDL_mutex *g_ttfMutex = NULL;
+
+//size cache, only touched by the thread that renders
+static OpenFont g_openFonts[MAX_OPEN_FONTS];
+static int g_openCount = 0;
+
+static const FontFile *findFile(const char *path) {
+    int count = SDL_AtomicGet(&g_fileCount);
+    SDL_MemoryBarrierAcquire();
+    for (int i = 0; i < count; i++) {
+        if (strcmp(g_files[i].path, path) == 0) return &g_files[i];
+    }
+    return NULL;
+}
+
+/**
+ * Looks the file up, reading it on first use. The read happens outside the lock, if two threads race the
+ * second copy is dropped
+ *
+ * @return the entry, NULL if the path is too long or every slot is taken
+ */
+static const FontFile *loadFile(const char *path) {
+    const FontFile *file = findFile(path);
+    if (file) return file;
+    if (strlen(path) >= MAX_FONT_PATH) return NULL;
+
+    size_t size = 0;
+    void *bytes = SDL_LoadFile(path, &size);
+    if (!bytes) printf("[WARNING] Failed to read font %s, using %s instead\n", path, FONT_FALLBACK);
+
+    SDL_AtomicLock(&g_filesLock);
+    file = findFile(path);
+    if (!file && SDL_AtomicGet(&g_fileCount) < MAX_FONT_FILES) {
+        FontFile *entry = &g_files[SDL_AtomicGet(&g_fileCount)];
+        strcpy(entry->path, path);
+        entry->bytes = bytes;
+        entry->size = size;
+        bytes = NULL;
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicAdd(&g_fileCount, 1);
+        file = entry;
+    }
+    SDL_AtomicUnlock(&g_filesLock);
+
+    if (bytes) SDL_free(bytes);
+    return file;
+}
+
+//the file's own bytes, or the fallback's when it couldn't be read
+static const FontFile *resolveFile(const char *path) {
+    const FontFile *file = loadFile(path);
+    if ((!file || !file->bytes) && strcmp(path, FONT_FALLBACK) != 0) file = loadFile(FONT_FALLBACK);
+    return file && file->bytes ? file : NULL;
+}
+
+static TTF_Font *openFromFile(const FontFile *file, int size) {
+    SDL_RWops *rw = SDL_RWFromConstMem(file->bytes, (int) file->size);
+    if (!rw) return NULL;
+    fontManagerLock();
+    TTF_Font *font = TTF_OpenFontRW(rw, 1, size);
+    if (!font) printf("[ERROR] Failed to open font %s at %d: %s\n", file->path, size, TTF_GetError());
+    fontManagerUnlock();
+    return font;
+}
+
+void fontManagerLock(void) {
+    SDL_mutex *mutex = SDL_AtomicGetPtr((void **) &g_ttfMutex);
+    if (!mutex) {
+        SDL_AtomicLock(&g_filesLock);
+        mutex = g_ttfMutex ? g_ttfMutex : SDL_CreateMutex();
+        SDL_AtomicSetPtr((void **) &g_ttfMutex, mutex);
+        SDL_AtomicUnlock(&g_filesLock);
+    }
+    if (mutex) SDL_LockMutex(mutex);
+}
+
+void fontManagerUnlock(void) {
+    SDL_mutex *mutex = SDL_AtomicGetPtr((void **) &g_ttfMutex);
+    if (mutex) SDL_UnlockMutex(mutex);
+}
+
+bool fontManagerPreload(const char *path) {
+    const FontFile *file = loadFile(path);
+    return file && file->bytes;
+}
+
+TTF_Font *fontManagerGet(const char *path, int size) {
+    const FontFile *file = resolveFile(path);
+    if (!file) return NULL;
+
+    OpenFont *closest = NULL;
+    for (int i = 0; i < g_openCount; i++) {
+        OpenFont *open = &g_openFonts[i];
+        if (open->file != file) continue;
+        if (open->size == size) return open->font;
+        if (!closest || abs(open->size - size) < abs(closest->size - size)) closest = open;
+    }
+
+    //sizes follow the window, a full cache hands out the nearest size rather than growing forever
+    if (g_openCount >= MAX_OPEN_FONTS) return closest ? closest->font : NULL;
+
+    TTF_Font *font = openFromFile(file, size);
+    if (!font) return NULL;
+    g_openFonts[g_openCount++] = (OpenFont) {file, size, font};
+    return font;
+}
+
+TTF_Font *fontManagerOpen(const char *path, int size) {
+    const FontFile *file = resolveFile(path);
+    return file ? openFromFile(file, size) : NULL;
+}
+
+void fontManagerClose(TTF_Font *font) {
+    if (!font) return;
+    fontManagerLock();
+    TTF_CloseFont(font);
+    fontManagerUnlock();
+}
+
+void fontManagerDestroy(void) {
+    fontManagerLock();
+    for (int i = 0; i < g_openCount; i++) TTF_CloseFont(g_openFonts[i].font);
+    g_openCount = 0;
+    fontManagerUnlock();
+
+    SDL_AtomicLock(&g_filesLock);
+    int count = SDL_AtomicGet(&g_fileCount);
+    for (int i = 0; i < count; i++) {
+        if (g_files[i].bytes) SDL_free(g_files[i].bytes);
+        memset(&g_files[i], 0, sizeof(FontFile));
+    }
+    SDL_AtomicSet(&g_fileCount, 0);
+    SDL_mutex *mutex = SDL_AtomicSetPtr((void **) &g_ttfMutex, NULL);
+    SDL_AtomicUnlock(&g_filesLock);
+    if (mutex) SDL_DestroyMutex(mutex);
+}
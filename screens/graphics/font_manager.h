@@ -0,0 +1,40 @@
+#ifndef FONT_MANAGER_H
+#define FONT_MANAGER_H
+
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+
+/*
+ * Every font file is read into memory once, on the loader thread where possible, and each size is opened from
+ * those bytes instead of going back to the disk. Sizes opened through fontManagerGet are cached for the whole run.
+ *
+ * SDL_ttf keeps one FreeType library for every font and none of it is thread safe, so every TTF_ call on any
+ * thread happens between fontManagerLock and fontManagerUnlock. The lock is recursive, the manager takes it itself
+ * to open and close fonts.
+ */
+
+#define FONT_PIXELIFY_BOLD "resources/font/PixelifySans-Bold.ttf"
+#define FONT_PIXELIFY_SEMIBOLD "resources/font/PixelifySans-SemiBold.ttf"
+#define FONT_MOTA_PIXEL_BOLD "resources/font/MotaPixel-Bold.otf"
+
+//used in place of any font file that can't be read
+#define FONT_FALLBACK FONT_PIXELIFY_SEMIBOLD
+
+//reads the file into memory once, safe on any thread. Later opens of any size parse it from there
+bool fontManagerPreload(const char *path);
+
+//shared font of that file and size, opened once and kept until fontManagerDestroy. Only on the thread that renders
+TTF_Font *fontManagerGet(const char *path, int size);
+
+//a private font from the preloaded bytes for other threads, closed with fontManagerClose
+TTF_Font *fontManagerOpen(const char *path, int size);
+
+void fontManagerClose(TTF_Font *font);
+
+void fontManagerLock(void);
+
+void fontManagerUnlock(void);
+
+void fontManagerDestroy(void);
+
+#endif
@@ -0,0 +1,264 @@
+#include "resource_registry.h"
+#include "font_manager.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_RESOURCES 1024
+#define INDEX_BITS 16
+#define INDEX_MASK ((1u << INDEX_BITS) - 1)
+
+typedef struct {
+    bool used;           //alive or waiting for resourceCollect
+    ResourceType type;
+    uint16_t generation; //bumped on destruction, old handles stop matching
+    int refs;            //0 once released, the slot is then queued
+    uint64_t hash;       //content key for sharing, 0 if never shared
+    void *object;
+} ResourceSlot;
+
+static ResourceSlot slots[MAX_RESOURCES];
+
+static uint64_t mixHash(uint64_t hash, uint64_t value) {
+    hash ^= value;
+    hash *= 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+}
+
+static ResourceSlot *resolve(ResourceHandle handle, ResourceType type) {
+    uint32_t index = handle & INDEX_MASK;
+    if (!handle || index >= MAX_RESOURCES) return NULL;
+    ResourceSlot *slot = &slots[index];
+    if (!slot->used || slot->refs <= 0 || slot->type != type || slot->generation != handle >> INDEX_BITS) return NULL;
+    return slot;
+}
+
+static ResourceHandle handleOf(const ResourceSlot *slot) {
+    return (ResourceHandle) slot->generation << INDEX_BITS | (uint32_t) (slot - slots);
+}
+
+/**
+ * Finds a resource of the same type and content, queued ones are brought back
+ *
+ * @return a new reference to it, 0 if there is none
+ */
+static ResourceHandle findShared(ResourceType type, uint64_t hash) {
+    if (!hash) return 0;
+    for (int i = 0; i < MAX_RESOURCES; i++) {
+        ResourceSlot *slot = &slots[i];
+        if (slot->used && slot->type == type && slot->hash == hash) {
+            slot->refs++;
+            return handleOf(slot);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Stores object in a free slot with one reference
+ *
+ * @return its handle, 0 if the registry is full
+ */
+static ResourceHandle addResource(ResourceType type, void *object, uint64_t hash) {
+    for (int i = 0; i < MAX_RESOURCES; i++) {
+        ResourceSlot *slot = &slots[i];
+        if (slot->used) continue;
+        if (!slot->generation) slot->generation = 1;
+        slot->used = true;
+        slot->type = type;
+        slot->refs = 1;
+        slot->hash = hash;
+        slot->object = object;
+        return handleOf(slot);
+    }
+    printf("[ERROR] Resource registry is full\n");
+    return 0;
+}
+
+static void destroyObject(ResourceType type, void *object) {
+    switch (type) {
+        case RESOURCE_TEXTURE:
+            SDL_DestroyTexture(object);
+            break;
+        case RESOURCE_SURFACE:
+            SDL_FreeSurface(object);
+            break;
+        case RESOURCE_FONT:
+            fontManagerClose(object);
+            break;
+        case RESOURCE_HIT_MASK:
+            free(((HitMask *) object)->bits);
+            free(object);
+            break;
+        default:
+            break;
+    }
+}
+
+bool hitMaskTest(const HitMask *mask, int x, int y) {
+    if (!mask || x < 0 || y < 0 || x >= mask->w || y >= mask->h) return false;
+    size_t bit = (size_t) y * mask->w + x;
+    return (mask->bits[bit >> 3] >> (bit & 7)) & 1;
+}
+
+uint64_t resourceHashSurface(SDL_Surface *surface) {
+    if (!surface) return 0;
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) return 0;
+
+    uint64_t hash = mixHash(0xcbf29ce484222325ull, (uint64_t) surface->w << 32 | (uint32_t) surface->h);
+    hash = mixHash(hash, surface->format->format);
+    size_t rowBytes = (size_t) surface->w * surface->format->BytesPerPixel;
+    for (int y = 0; y < surface->h; y++) {
+        const uint8_t *row = (const uint8_t *) surface->pixels + (size_t) y * surface->pitch;
+        size_t i = 0;
+        for (; i + 8 <= rowBytes; i += 8) {
+            uint64_t word;
+            memcpy(&word, row + i, 8);
+            hash = mixHash(hash, word);
+        }
+        for (; i < rowBytes; i++) hash = mixHash(hash, row[i]);
+    }
+
+    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+    return hash ? hash : 1;
+}
+
+ResourceHandle resourceAddSurface(SDL_Surface *surface, uint64_t hash) {
+    if (!surface) return 0;
+    ResourceHandle shared = findShared(RESOURCE_SURFACE, hash);
+    if (shared) {
+        SDL_FreeSurface(surface);
+        return shared;
+    }
+    ResourceHandle handle = addResource(RESOURCE_SURFACE, surface, hash);
+    if (!handle) SDL_FreeSurface(surface);
+    return handle;
+}
+
+ResourceHandle resourceCreateTexture(SDL_Renderer *renderer, ResourceHandle surface) {
+    ResourceSlot *source = resolve(surface, RESOURCE_SURFACE);
+    if (!source) return 0;
+    ResourceHandle shared = findShared(RESOURCE_TEXTURE, source->hash);
+    if (shared) return shared;
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, source->object);
+    if (!texture) {
+        printf("[ERROR] Failed to create texture: %s\n", SDL_GetError());
+        return 0;
+    }
+    ResourceHandle handle = addResource(RESOURCE_TEXTURE, texture, source->hash);
+    if (!handle) SDL_DestroyTexture(texture);
+    return handle;
+}
+
+ResourceHandle resourceCreateHitMask(ResourceHandle surface) {
+    ResourceSlot *source = resolve(surface, RESOURCE_SURFACE);
+    if (!source) return 0;
+    ResourceHandle shared = findShared(RESOURCE_HIT_MASK, source->hash);
+    if (shared) return shared;
+
+    SDL_Surface *surf = source->object;
+    HitMask *mask = malloc(sizeof(HitMask));
+    if (!mask) return 0;
+    mask->w = surf->w;
+    mask->h = surf->h;
+    mask->bits = calloc(((size_t) surf->w * surf->h + 7) / 8, 1);
+    if (!mask->bits || (SDL_MUSTLOCK(surf) && SDL_LockSurface(surf) != 0)) {
+        free(mask->bits);
+        free(mask);
+        return 0;
+    }
+
+    int bpp = surf->format->BytesPerPixel;
+    for (int y = 0; y < surf->h; y++) {
+        const uint8_t *row = (const uint8_t *) surf->pixels + (size_t) y * surf->pitch;
+        for (int x = 0; x < surf->w; x++) {
+            Uint32 pixel = 0;
+            memcpy(&pixel, row + (size_t) x * bpp, bpp);
+            Uint8 r, g, b, a;
+            SDL_GetRGBA(pixel, surf->format, &r, &g, &b, &a);
+            if (a > 0) {
+                size_t bit = (size_t) y * surf->w + x;
+                mask->bits[bit >> 3] |= (uint8_t) (1 << (bit & 7));
+            }
+        }
+    }
+    if (SDL_MUSTLOCK(surf)) SDL_UnlockSurface(surf);
+
+    ResourceHandle handle = addResource(RESOURCE_HIT_MASK, mask, source->hash);
+    if (!handle) destroyObject(RESOURCE_HIT_MASK, mask);
+    return handle;
+}
+
+ResourceHandle resourceOpenFont(const char *path, int size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char *c = path; *c; c++) hash = mixHash(hash, (unsigned char) *c);
+    hash = mixHash(hash, (uint64_t) size);
+    if (!hash) hash = 1;
+
+    ResourceHandle shared = findShared(RESOURCE_FONT, hash);
+    if (shared) return shared;
+
+    TTF_Font *font = fontManagerOpen(path, size);
+    if (!font) return 0;
+    ResourceHandle handle = addResource(RESOURCE_FONT, font, hash);
+    if (!handle) fontManagerClose(font);
+    return handle;
+}
+
+ResourceHandle resourceRetain(ResourceHandle handle) {
+    uint32_t index = handle & INDEX_MASK;
+    if (!handle || index >= MAX_RESOURCES) return 0;
+    ResourceSlot *slot = &slots[index];
+    if (!slot->used || slot->refs <= 0 || slot->generation != handle >> INDEX_BITS) return 0;
+    slot->refs++;
+    return handle;
+}
+
+void resourceRelease(ResourceHandle handle) {
+    uint32_t index = handle & INDEX_MASK;
+    if (!handle || index >= MAX_RESOURCES) return;
+    ResourceSlot *slot = &slots[index];
+    if (!slot->used || slot->refs <= 0 || slot->generation != handle >> INDEX_BITS) return;
+    slot->refs--;
+}
+
+void resourceCollect(void) {
+    for (int i = 0; i < MAX_RESOURCES; i++) {
+        ResourceSlot *slot = &slots[i];
+        if (!slot->used || slot->refs > 0) continue;
+
+        destroyObject(slot->type, slot->object);
+        slot->used = false;
+        slot->object = NULL;
+        slot->hash = 0;
+        slot->generation++;
+        if (!slot->generation) slot->generation = 1;
+    }
+}
+
+SDL_Texture *resourceGetTexture(ResourceHandle handle) {
+    ResourceSlot *slot = resolve(handle, RESOURCE_TEXTURE);
+    return slot ? slot->object : NULL;
+}
+
+SDL_Surface *resourceGetSurface(ResourceHandle handle) {
+    ResourceSlot *slot = resolve(handle, RESOURCE_SURFACE);
+    return slot ? slot->object : NULL;
+}
+
+TTF_Font *resourceGetFont(ResourceHandle handle) {
+    ResourceSlot *slot = resolve(handle, RESOURCE_FONT);
+    return slot ? slot->object : NULL;
+}
+
+const HitMask *resourceGetHitMask(ResourceHandle handle) {
+    ResourceSlot *slot = resolve(handle, RESOURCE_HIT_MASK);
+    return slot ? slot->object : NULL;
+}
+
+int resourceCount(void) {
+    int count = 0;
+    for (int i = 0; i < MAX_RESOURCES; i++) count += slots[i].used;
+    return count;
+}
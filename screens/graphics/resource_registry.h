@@ -0,0 +1,70 @@
+#ifndef RESOURCE_REGISTRY_H
+#define RESOURCE_REGISTRY_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Owns every texture, surface, font and hit mask the screens share. Resources are reached through handles that
+ * carry the slot's generation, so a handle to something already destroyed resolves to NULL instead of a freed
+ * pointer. Each holder takes its own reference; a resource whose last reference is released is only queued,
+ * resourceCollect destroys everything queued at once. Resources with the same content hash are shared.
+ *
+ * Main thread only, resourceHashSurface is the one function safe to call from the loader thread
+ */
+
+//0 is never handed out, so zeroed structs hold no resource
+typedef uint32_t ResourceHandle;
+
+typedef enum {
+    RESOURCE_TEXTURE,
+    RESOURCE_SURFACE,
+    RESOURCE_FONT,
+    RESOURCE_HIT_MASK,
+    RESOURCE_TYPES
+} ResourceType;
+
+//one bit per pixel, set where the source image isn't fully transparent
+typedef struct {
+    int w, h;
+    uint8_t *bits;
+} HitMask;
+
+bool hitMaskTest(const HitMask *mask, int x, int y);
+
+uint64_t resourceHashSurface(SDL_Surface *surface);
+
+//takes ownership of surface, frees it right away if the same pixels are registered already
+ResourceHandle resourceAddSurface(SDL_Surface *surface, uint64_t hash);
+
+//texture and hit mask of a registered surface, shared with every other surface of the same content
+ResourceHandle resourceCreateTexture(SDL_Renderer *renderer, ResourceHandle surface);
+
+ResourceHandle resourceCreateHitMask(ResourceHandle surface);
+
+//the same file and size opened twice share one font
+ResourceHandle resourceOpenFont(const char *path, int size);
+
+ResourceHandle resourceRetain(ResourceHandle handle);
+
+//drops one reference, the last one queues the resource for resourceCollect
+void resourceRelease(ResourceHandle handle);
+
+//destroys every queued resource, call before the renderer goes away
+void resourceCollect(void);
+
+//NULL for stale handles and handles of another type
+SDL_Texture *resourceGetTexture(ResourceHandle handle);
+
+SDL_Surface *resourceGetSurface(ResourceHandle handle);
+
+TTF_Font *resourceGetFont(ResourceHandle handle);
+
+const HitMask *resourceGetHitMask(ResourceHandle handle);
+
+//resources alive or queued, for leak checks
+int resourceCount(void);
+
+#endif
@@ -3,37 +3,132 @@
 #include <SDL2/SDL_thread.h>
 #include <stdio.h>
 #include <string.h>
+#include "font_manager.h"
+
+#define MAX_OWNED 512
 
 //global texture instances
 MainMenuTextures g_mainMenuTextures = {0};
 IngameUITextures g_ingameUITextures = {0};
 AboutSectionTextures g_aboutTextures = {0};
 
+//a surface decoded by the loader thread, hashed there too so the main thread only has to upload it
+typedef struct {
+    SDL_Surface *surface;
+    uint64_t hash;
+} LoadedSurface;
+
 //surface storage for async loading
 static struct {
-    SDL_Surface *mainMenu_bg;
-    SDL_Surface *mainMenu_start;
-    SDL_Surface *mainMenu_startHover;
-    SDL_Surface *mainMenu_about;
-    SDL_Surface *mainMenu_aboutHover;
-
-    SDL_Surface *about_bg;
-
-    SDL_Surface *ingame_frames[180];
-    SDL_Surface *ingame_lives[7];
-    SDL_Surface *ingame_pause;
-    SDL_Surface *ingame_lettersPull;
-    SDL_Surface *ingame_lettersPulled;
-    SDL_Surface *ingame_powerBg;
-    SDL_Surface *ingame_powerBoxes[9];
+    LoadedSurface mainMenu_bg;
+    LoadedSurface mainMenu_start;
+    LoadedSurface mainMenu_startHover;
+    LoadedSurface mainMenu_about;
+    LoadedSurface mainMenu_aboutHover;
+
+    LoadedSurface about_bg;
+
+    LoadedSurface ingame_frames[180];
+    LoadedSurface ingame_framesLow[90];
+    LoadedSurface ingame_lives[7];
+    LoadedSurface ingame_pause;
+    LoadedSurface ingame_lettersPull;
+    LoadedSurface ingame_lettersPulled;
+    LoadedSurface ingame_powerBg;
+    LoadedSurface ingame_powerBoxes[9];
 } g_loadedSurfaces = {0};
 
+//registry references behind the pointers in each global, dropped together when that screen's textures go
+typedef struct {
+    ResourceHandle handles[MAX_OWNED];
+    int count;
+} OwnedResources;
+
+static OwnedResources g_mainMenuOwned;
+static OwnedResources g_ingameOwned;
+static OwnedResources g_aboutOwned;
+
 //threading state
 static SDL_Thread *g_loadThread = NULL;
 static SDL_atomic_t g_loadProgress;
 static SDL_atomic_t g_surfacesLoaded;
 static SDL_atomic_t g_texturesCreated;
 
+// ============================================================================
+// SHARED HELPERS
+// ============================================================================
+
+static ResourceHandle own(OwnedResources *owned, ResourceHandle handle) {
+    if (!handle) return 0;
+    if (owned->count >= MAX_OWNED) {
+        printf("[ERROR] Too many resources for one screen\n");
+        resourceRelease(handle);
+        return 0;
+    }
+    owned->handles[owned->count++] = handle;
+    return handle;
+}
+
+static void releaseOwned(OwnedResources *owned) {
+    for (int i = 0; i < owned->count; i++) resourceRelease(owned->handles[i]);
+    owned->count = 0;
+    resourceCollect();
+}
+
+//registers a decoded surface and uploads it, optionally keeping a hit mask. The surface itself isn't kept
+static ResourceHandle uploadSurface(SDL_Renderer *renderer, OwnedResources *owned, LoadedSurface loaded,
+                                    ResourceHandle *mask) {
+    if (mask) *mask = 0;
+    if (!loaded.surface) return 0;
+
+    uint64_t hash = loaded.hash ? loaded.hash : resourceHashSurface(loaded.surface);
+    ResourceHandle surface = resourceAddSurface(loaded.surface, hash);
+    ResourceHandle texture = own(owned, resourceCreateTexture(renderer, surface));
+    if (mask) *mask = own(owned, resourceCreateHitMask(surface));
+    resourceRelease(surface);
+    return texture;
+}
+
+//nearest neighbour copy at half the width and height, hashed like any loaded surface
+static LoadedSurface halfSize(SDL_Surface *source) {
+    LoadedSurface half = {NULL, 0};
+    if (!source) return half;
+    int w = source->w > 1 ? source->w / 2 : 1;
+    int h = source->h > 1 ? source->h / 2 : 1;
+    half.surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, source->format->BitsPerPixel, source->format->format);
+    if (!half.surface) return half;
+
+    //copy the pixels as they are instead of blending them onto the empty surface
+    SDL_BlendMode mode;
+    SDL_GetSurfaceBlendMode(source, &mode);
+    SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+    if (SDL_BlitScaled(source, NULL, half.surface, NULL) != 0) {
+        SDL_FreeSurface(half.surface);
+        half.surface = NULL;
+    }
+    SDL_SetSurfaceBlendMode(source, mode);
+
+    half.hash = resourceHashSurface(half.surface);
+    return half;
+}
+
+static LoadedSurface loadNow(const char *path) {
+    LoadedSurface loaded = {IMG_Load(path), 0};
+    return loaded;
+}
+
+//either letters image stands in for the other when it's missing, both sides hold their own reference
+static void setLetters(ResourceHandle textures[2], ResourceHandle masks[2]) {
+    for (int i = 0; i < 2; i++) {
+        if (!textures[i] && textures[1 - i]) {
+            textures[i] = own(&g_ingameOwned, resourceRetain(textures[1 - i]));
+            masks[i] = own(&g_ingameOwned, resourceRetain(masks[1 - i]));
+        }
+        g_ingameUITextures.lettersTex[i] = resourceGetTexture(textures[i]);
+        g_ingameUITextures.lettersMask[i] = resourceGetHitMask(masks[i]);
+    }
+}
+
 // ============================================================================
 // MAIN MENU TEXTURES
 // ============================================================================
@@ -44,50 +139,43 @@ bool textureManagerInitMainMenu(SDL_Renderer *renderer) {
         return false;
     }
 
-    g_mainMenuTextures.background = IMG_LoadTexture(renderer, "resources/textures/main_menu/background.png");
+    ResourceHandle texture, mask;
+
+    texture = uploadSurface(renderer, &g_mainMenuOwned, loadNow("resources/textures/main_menu/background.png"), NULL);
+    g_mainMenuTextures.background = resourceGetTexture(texture);
     if (!g_mainMenuTextures.background) {
         printf("[ERROR] Failed to load main menu background: %s\n", IMG_GetError());
         return false;
     }
 
-    g_mainMenuTextures.startSurface = IMG_Load("resources/textures/main_menu/start.png");
-    if (!g_mainMenuTextures.startSurface) {
+    texture = uploadSurface(renderer, &g_mainMenuOwned, loadNow("resources/textures/main_menu/start.png"), &mask);
+    g_mainMenuTextures.start = resourceGetTexture(texture);
+    g_mainMenuTextures.startMask = resourceGetHitMask(mask);
+    if (!g_mainMenuTextures.startMask) {
         printf("[ERROR] Failed to load start surface: %s\n", IMG_GetError());
         return false;
     }
-    g_mainMenuTextures.start = SDL_CreateTextureFromSurface(renderer, g_mainMenuTextures.startSurface);
 
-    SDL_Surface *startHoverSurf = IMG_Load("resources/textures/main_menu/start_hover.png");
-    if (startHoverSurf) {
-        g_mainMenuTextures.startHover = SDL_CreateTextureFromSurface(renderer, startHoverSurf);
-        SDL_FreeSurface(startHoverSurf);
-    }
+    texture = uploadSurface(renderer, &g_mainMenuOwned, loadNow("resources/textures/main_menu/start_hover.png"), NULL);
+    g_mainMenuTextures.startHover = resourceGetTexture(texture);
 
-    g_mainMenuTextures.aboutSurface = IMG_Load("resources/textures/main_menu/about.png");
-    if (!g_mainMenuTextures.aboutSurface) {
+    texture = uploadSurface(renderer, &g_mainMenuOwned, loadNow("resources/textures/main_menu/about.png"), &mask);
+    g_mainMenuTextures.about = resourceGetTexture(texture);
+    g_mainMenuTextures.aboutMask = resourceGetHitMask(mask);
+    if (!g_mainMenuTextures.aboutMask) {
         printf("[ERROR] Failed to load about surface: %s\n", IMG_GetError());
         return false;
     }
-    g_mainMenuTextures.about = SDL_CreateTextureFromSurface(renderer, g_mainMenuTextures.aboutSurface);
 
-    SDL_Surface *aboutHoverSurf = IMG_Load("resources/textures/main_menu/about_hover.png");
-    if (aboutHoverSurf) {
-        g_mainMenuTextures.aboutHover = SDL_CreateTextureFromSurface(renderer, aboutHoverSurf);
-        SDL_FreeSurface(aboutHoverSurf);
-    }
+    texture = uploadSurface(renderer, &g_mainMenuOwned, loadNow("resources/textures/main_menu/about_hover.png"), NULL);
+    g_mainMenuTextures.aboutHover = resourceGetTexture(texture);
 
+    resourceCollect();
     return true;
 }
 
 void textureManagerDestroyMainMenu(void) {
-    if (g_mainMenuTextures.background) SDL_DestroyTexture(g_mainMenuTextures.background);
-    if (g_mainMenuTextures.start) SDL_DestroyTexture(g_mainMenuTextures.start);
-    if (g_mainMenuTextures.startHover) SDL_DestroyTexture(g_mainMenuTextures.startHover);
-    if (g_mainMenuTextures.startSurface) SDL_FreeSurface(g_mainMenuTextures.startSurface);
-    if (g_mainMenuTextures.about) SDL_DestroyTexture(g_mainMenuTextures.about);
-    if (g_mainMenuTextures.aboutHover) SDL_DestroyTexture(g_mainMenuTextures.aboutHover);
-    if (g_mainMenuTextures.aboutSurface) SDL_FreeSurface(g_mainMenuTextures.aboutSurface);
-
+    releaseOwned(&g_mainMenuOwned);
     memset(&g_mainMenuTextures, 0, sizeof(MainMenuTextures));
 }
 
@@ -100,113 +188,47 @@ bool textureManagerInitIngameUi(SDL_Renderer *renderer) {
 
     for (int i = 0; i < 180; i++) {
         snprintf(path, sizeof(path), "resources/textures/ingame_ui/background_frames/background_frame_%03d.bmp", i + 1);
-        SDL_Surface *surf = SDL_LoadBMP(path);
-        if (!surf) {
-            g_ingameUITextures.frames[i] = NULL;
-            continue;
+        LoadedSurface frame = {SDL_LoadBMP(path), 0};
+        if (i % 2 == 0) {
+            g_ingameUITextures.framesLow[i / 2] =
+                    resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, halfSize(frame.surface), NULL));
         }
-        g_ingameUITextures.frames[i] = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
+        g_ingameUITextures.frames[i] = resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, frame, NULL));
     }
 
     for (int i = 0; i <= 6; i++) {
         snprintf(path, sizeof(path), "resources/textures/ingame_ui/%d_lives.png", i);
-        SDL_Surface *surf = IMG_Load(path);
-        if (!surf) {
-            g_ingameUITextures.livesTextures[i] = NULL;
-            continue;
-        }
-        g_ingameUITextures.livesTextures[i] = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
+        g_ingameUITextures.livesTextures[i] =
+                resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, loadNow(path), NULL));
     }
 
-    SDL_Surface *surf = IMG_Load("resources/textures/ingame_ui/pause_menu.png");
-    if (surf) {
-        g_ingameUITextures.pauseTex = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-    }
+    g_ingameUITextures.pauseTex = resourceGetTexture(
+        uploadSurface(renderer, &g_ingameOwned, loadNow("resources/textures/ingame_ui/pause_menu.png"), NULL));
 
-    surf = IMG_Load("resources/textures/ingame_ui/letters_used_pull.png");
-    if (surf) {
-        g_ingameUITextures.lettersSurf[0] = surf;
-        g_ingameUITextures.lettersTex[0] = SDL_CreateTextureFromSurface(renderer, surf);
-    }
-
-    surf = IMG_Load("resources/textures/ingame_ui/letters_used_pulled.png");
-    if (surf) {
-        g_ingameUITextures.lettersSurf[1] = surf;
-        g_ingameUITextures.lettersTex[1] = SDL_CreateTextureFromSurface(renderer, surf);
-    }
+    ResourceHandle letters[2], lettersMasks[2];
+    letters[0] = uploadSurface(renderer, &g_ingameOwned,
+                               loadNow("resources/textures/ingame_ui/letters_used_pull.png"), &lettersMasks[0]);
+    letters[1] = uploadSurface(renderer, &g_ingameOwned,
+                               loadNow("resources/textures/ingame_ui/letters_used_pulled.png"), &lettersMasks[1]);
+    setLetters(letters, lettersMasks);
 
-    if (!g_ingameUITextures.lettersTex[0] && g_ingameUITextures.lettersTex[1]) {
-        g_ingameUITextures.lettersTex[0] = g_ingameUITextures.lettersTex[1];
-        g_ingameUITextures.lettersSurf[0] = g_ingameUITextures.lettersSurf[1];
-    }
-    if (!g_ingameUITextures.lettersTex[1] && g_ingameUITextures.lettersTex[0]) {
-        g_ingameUITextures.lettersTex[1] = g_ingameUITextures.lettersTex[0];
-        g_ingameUITextures.lettersSurf[1] = g_ingameUITextures.lettersSurf[0];
-    }
-
-    surf = IMG_Load("resources/textures/ingame_ui/power_ui/power.png");
-    if (surf) {
-        g_ingameUITextures.powerUI_bg = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-    }
+    g_ingameUITextures.powerUI_bg = resourceGetTexture(
+        uploadSurface(renderer, &g_ingameOwned, loadNow("resources/textures/ingame_ui/power_ui/power.png"), NULL));
 
     for (int i = 0; i < 9; i++) {
         snprintf(path, sizeof(path), "resources/textures/ingame_ui/power_ui/box%d.png", i + 1);
-        SDL_Surface *surf = IMG_Load(path);
-        if (surf) {
-            g_ingameUITextures.powerUI_boxSurfs[i] = surf;
-            g_ingameUITextures.powerUI_boxes[i] = SDL_CreateTextureFromSurface(renderer, surf);
-        }
+        ResourceHandle mask;
+        g_ingameUITextures.powerUI_boxes[i] =
+                resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, loadNow(path), &mask));
+        g_ingameUITextures.powerUI_boxMasks[i] = resourceGetHitMask(mask);
     }
 
+    resourceCollect();
     return true;
 }
 
 void textureManagerDestroyIngameUi(void) {
-    for (int i = 0; i < 180; i++) {
-        if (g_ingameUITextures.frames[i]) {
-            SDL_DestroyTexture(g_ingameUITextures.frames[i]);
-        }
-    }
-
-    for (int i = 0; i <= 6; i++) {
-        if (g_ingameUITextures.livesTextures[i]) {
-            SDL_DestroyTexture(g_ingameUITextures.livesTextures[i]);
-        }
-    }
-
-    if (g_ingameUITextures.pauseTex) SDL_DestroyTexture(g_ingameUITextures.pauseTex);
-
-    if (g_ingameUITextures.lettersTex[0] &&
-        g_ingameUITextures.lettersTex[0] != g_ingameUITextures.lettersTex[1]) {
-        SDL_DestroyTexture(g_ingameUITextures.lettersTex[0]);
-    }
-    if (g_ingameUITextures.lettersTex[1]) {
-        SDL_DestroyTexture(g_ingameUITextures.lettersTex[1]);
-    }
-
-    if (g_ingameUITextures.lettersSurf[0] &&
-        g_ingameUITextures.lettersSurf[0] != g_ingameUITextures.lettersSurf[1]) {
-        SDL_FreeSurface(g_ingameUITextures.lettersSurf[0]);
-    }
-    if (g_ingameUITextures.lettersSurf[1]) {
-        SDL_FreeSurface(g_ingameUITextures.lettersSurf[1]);
-    }
-
-    if (g_ingameUITextures.powerUI_bg) SDL_DestroyTexture(g_ingameUITextures.powerUI_bg);
-
-    for (int i = 0; i < 9; i++) {
-        if (g_ingameUITextures.powerUI_boxes[i]) {
-            SDL_DestroyTexture(g_ingameUITextures.powerUI_boxes[i]);
-        }
-        if (g_ingameUITextures.powerUI_boxSurfs[i]) {
-            SDL_FreeSurface(g_ingameUITextures.powerUI_boxSurfs[i]);
-        }
-    }
-
+    releaseOwned(&g_ingameOwned);
     memset(&g_ingameUITextures, 0, sizeof(IngameUITextures));
 }
 
@@ -220,7 +242,9 @@ bool textureManagerInitAboutSection(SDL_Renderer *renderer) {
         return false;
     }
 
-    g_aboutTextures.background = IMG_LoadTexture(renderer, "resources/textures/about_section/background.png");
+    g_aboutTextures.background = resourceGetTexture(
+        uploadSurface(renderer, &g_aboutOwned, loadNow("resources/textures/about_section/background.png"), NULL));
+    resourceCollect();
     if (!g_aboutTextures.background) {
         printf("[ERROR] Failed to load about section background: %s\n", IMG_GetError());
         return false;
@@ -230,7 +254,7 @@ bool textureManagerInitAboutSection(SDL_Renderer *renderer) {
 }
 
 void textureManagerDestroyAboutSection(void) {
-    if (g_aboutTextures.background) SDL_DestroyTexture(g_aboutTextures.background);
+    releaseOwned(&g_aboutOwned);
     memset(&g_aboutTextures, 0, sizeof(AboutSectionTextures));
 }
 
@@ -259,6 +283,14 @@ void textureManagerDestroyAll(void) {
 // THREADED LOADING IMPLEMENTATION
 // ============================================================================
 
+//decodes and hashes one image, then moves the progress on
+static void loadInThread(LoadedSurface *out, const char *path, int *currentItem, int totalItems) {
+    out->surface = IMG_Load(path);
+    out->hash = resourceHashSurface(out->surface);
+    (*currentItem)++;
+    SDL_AtomicSet(&g_loadProgress, (int) ((*currentItem / (float) totalItems) * 100.0f));
+}
+
 static int surfaceLoadThread(void *data) {
     char path[512];
     int totalItems = 5 + 1 + 180 + 7 + 1 + 2 + 1 + 9; //total surface count = 206
@@ -271,59 +303,53 @@ static int surfaceLoadThread(void *data) {
 
     SDL_AtomicSet(&g_loadProgress, 0);
 
-    // Load main menu surfaces
-    g_loadedSurfaces.mainMenu_bg = IMG_Load("resources/textures/main_menu/background.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
-
-    g_loadedSurfaces.mainMenu_start = IMG_Load("resources/textures/main_menu/start.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
-
-    g_loadedSurfaces.mainMenu_startHover = IMG_Load("resources/textures/main_menu/start_hover.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+    // Read the fonts the menus and the game use, their sizes are opened from memory later
+    fontManagerPreload(FONT_PIXELIFY_SEMIBOLD);
+    fontManagerPreload(FONT_MOTA_PIXEL_BOLD);
 
-    g_loadedSurfaces.mainMenu_about = IMG_Load("resources/textures/main_menu/about.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
-
-    g_loadedSurfaces.mainMenu_aboutHover = IMG_Load("resources/textures/main_menu/about_hover.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+    // Load main menu surfaces
+    loadInThread(&g_loadedSurfaces.mainMenu_bg, "resources/textures/main_menu/background.png", &currentItem, totalItems);
+    loadInThread(&g_loadedSurfaces.mainMenu_start, "resources/textures/main_menu/start.png", &currentItem, totalItems);
+    loadInThread(&g_loadedSurfaces.mainMenu_startHover, "resources/textures/main_menu/start_hover.png", &currentItem,
+                 totalItems);
+    loadInThread(&g_loadedSurfaces.mainMenu_about, "resources/textures/main_menu/about.png", &currentItem, totalItems);
+    loadInThread(&g_loadedSurfaces.mainMenu_aboutHover, "resources/textures/main_menu/about_hover.png", &currentItem,
+                 totalItems);
 
     // Load about section
-    g_loadedSurfaces.about_bg = IMG_Load("resources/textures/about_section/background.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+    loadInThread(&g_loadedSurfaces.about_bg, "resources/textures/about_section/background.png", &currentItem,
+                 totalItems);
 
     // Load ingame frames (180 BMPs)
     for (int i = 0; i < 180; i++) {
         snprintf(path, sizeof(path), "resources/textures/ingame_ui/background_frames/background_frame_%03d.png", i + 1);
-        g_loadedSurfaces.ingame_frames[i] = IMG_Load(path);
-        currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+        loadInThread(&g_loadedSurfaces.ingame_frames[i], path, &currentItem, totalItems);
+        if (i % 2 == 0) g_loadedSurfaces.ingame_framesLow[i / 2] = halfSize(g_loadedSurfaces.ingame_frames[i].surface);
     }
 
     // Load lives (7 PNGs)
     for (int i = 0; i <= 6; i++) {
         snprintf(path, sizeof(path), "resources/textures/ingame_ui/%d_lives.png", i);
-        g_loadedSurfaces.ingame_lives[i] = IMG_Load(path);
-        currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+        loadInThread(&g_loadedSurfaces.ingame_lives[i], path, &currentItem, totalItems);
     }
 
     // Load pause menu
-    g_loadedSurfaces.ingame_pause = IMG_Load("resources/textures/ingame_ui/pause_menu.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+    loadInThread(&g_loadedSurfaces.ingame_pause, "resources/textures/ingame_ui/pause_menu.png", &currentItem,
+                 totalItems);
 
     // Load letters
-    g_loadedSurfaces.ingame_lettersPull = IMG_Load("resources/textures/ingame_ui/letters_used_pull.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
-
-    g_loadedSurfaces.ingame_lettersPulled = IMG_Load("resources/textures/ingame_ui/letters_used_pulled.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+    loadInThread(&g_loadedSurfaces.ingame_lettersPull, "resources/textures/ingame_ui/letters_used_pull.png",
+                 &currentItem, totalItems);
+    loadInThread(&g_loadedSurfaces.ingame_lettersPulled, "resources/textures/ingame_ui/letters_used_pulled.png",
+                 &currentItem, totalItems);
 
     // Load power UI
-    g_loadedSurfaces.ingame_powerBg = IMG_Load("resources/textures/ingame_ui/power_ui/power.png");
-    currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+    loadInThread(&g_loadedSurfaces.ingame_powerBg, "resources/textures/ingame_ui/power_ui/power.png", &currentItem,
+                 totalItems);
 
     for (int i = 0; i < 9; i++) {
         snprintf(path, sizeof(path), "resources/textures/ingame_ui/power_ui/box%d.png", i + 1);
-        g_loadedSurfaces.ingame_powerBoxes[i] = IMG_Load(path);
-        currentItem++; SDL_AtomicSet(&g_loadProgress, (int)((currentItem / (float)totalItems) * 100.0f));
+        loadInThread(&g_loadedSurfaces.ingame_powerBoxes[i], path, &currentItem, totalItems);
     }
 
     SDL_AtomicSet(&g_loadProgress, 100);
@@ -361,96 +387,71 @@ bool textureManagerProcessLoadedSurfaces(SDL_Renderer *renderer) {
         g_loadThread = NULL;
     }
 
-    // Create textures from loaded surfaces on main thread
+    // Create textures from loaded surfaces on main thread, the registry takes the surfaces over
+    ResourceHandle mask;
 
     // Main menu
-    if (g_loadedSurfaces.mainMenu_bg) {
-        g_mainMenuTextures.background = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.mainMenu_bg);
-        SDL_FreeSurface(g_loadedSurfaces.mainMenu_bg);
-    }
+    g_mainMenuTextures.background =
+            resourceGetTexture(uploadSurface(renderer, &g_mainMenuOwned, g_loadedSurfaces.mainMenu_bg, NULL));
 
-    if (g_loadedSurfaces.mainMenu_start) {
-        g_mainMenuTextures.startSurface = g_loadedSurfaces.mainMenu_start; // Keep surface
-        g_mainMenuTextures.start = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.mainMenu_start);
-    }
+    g_mainMenuTextures.start =
+            resourceGetTexture(uploadSurface(renderer, &g_mainMenuOwned, g_loadedSurfaces.mainMenu_start, &mask));
+    g_mainMenuTextures.startMask = resourceGetHitMask(mask);
 
-    if (g_loadedSurfaces.mainMenu_startHover) {
-        g_mainMenuTextures.startHover = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.mainMenu_startHover);
-        SDL_FreeSurface(g_loadedSurfaces.mainMenu_startHover);
-    }
+    g_mainMenuTextures.startHover =
+            resourceGetTexture(uploadSurface(renderer, &g_mainMenuOwned, g_loadedSurfaces.mainMenu_startHover, NULL));
 
-    if (g_loadedSurfaces.mainMenu_about) {
-        g_mainMenuTextures.aboutSurface = g_loadedSurfaces.mainMenu_about; // Keep surface
-        g_mainMenuTextures.about = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.mainMenu_about);
-    }
+    g_mainMenuTextures.about =
+            resourceGetTexture(uploadSurface(renderer, &g_mainMenuOwned, g_loadedSurfaces.mainMenu_about, &mask));
+    g_mainMenuTextures.aboutMask = resourceGetHitMask(mask);
 
-    if (g_loadedSurfaces.mainMenu_aboutHover) {
-        g_mainMenuTextures.aboutHover = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.mainMenu_aboutHover);
-        SDL_FreeSurface(g_loadedSurfaces.mainMenu_aboutHover);
-    }
+    g_mainMenuTextures.aboutHover =
+            resourceGetTexture(uploadSurface(renderer, &g_mainMenuOwned, g_loadedSurfaces.mainMenu_aboutHover, NULL));
 
     // About section
-    if (g_loadedSurfaces.about_bg) {
-        g_aboutTextures.background = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.about_bg);
-        SDL_FreeSurface(g_loadedSurfaces.about_bg);
-    }
+    g_aboutTextures.background =
+            resourceGetTexture(uploadSurface(renderer, &g_aboutOwned, g_loadedSurfaces.about_bg, NULL));
 
     // Ingame frames
     for (int i = 0; i < 180; i++) {
-        if (g_loadedSurfaces.ingame_frames[i]) {
-            g_ingameUITextures.frames[i] = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_frames[i]);
-            SDL_FreeSurface(g_loadedSurfaces.ingame_frames[i]);
-        }
+        g_ingameUITextures.frames[i] =
+                resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_frames[i], NULL));
+    }
+    for (int i = 0; i < 90; i++) {
+        g_ingameUITextures.framesLow[i] =
+                resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_framesLow[i], NULL));
     }
 
     // Ingame lives
     for (int i = 0; i <= 6; i++) {
-        if (g_loadedSurfaces.ingame_lives[i]) {
-            g_ingameUITextures.livesTextures[i] = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_lives[i]);
-            SDL_FreeSurface(g_loadedSurfaces.ingame_lives[i]);
-        }
+        g_ingameUITextures.livesTextures[i] =
+                resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_lives[i], NULL));
     }
 
     // Pause
-    if (g_loadedSurfaces.ingame_pause) {
-        g_ingameUITextures.pauseTex = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_pause);
-        SDL_FreeSurface(g_loadedSurfaces.ingame_pause);
-    }
+    g_ingameUITextures.pauseTex =
+            resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_pause, NULL));
 
     // Letters
-    if (g_loadedSurfaces.ingame_lettersPull) {
-        g_ingameUITextures.lettersSurf[0] = g_loadedSurfaces.ingame_lettersPull; // Keep surface
-        g_ingameUITextures.lettersTex[0] = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_lettersPull);
-    }
-
-    if (g_loadedSurfaces.ingame_lettersPulled) {
-        g_ingameUITextures.lettersSurf[1] = g_loadedSurfaces.ingame_lettersPulled; // Keep surface
-        g_ingameUITextures.lettersTex[1] = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_lettersPulled);
-    }
-
-    // Fallback for letters
-    if (!g_ingameUITextures.lettersTex[0] && g_ingameUITextures.lettersTex[1]) {
-        g_ingameUITextures.lettersTex[0] = g_ingameUITextures.lettersTex[1];
-        g_ingameUITextures.lettersSurf[0] = g_ingameUITextures.lettersSurf[1];
-    }
-    if (!g_ingameUITextures.lettersTex[1] && g_ingameUITextures.lettersTex[0]) {
-        g_ingameUITextures.lettersTex[1] = g_ingameUITextures.lettersTex[0];
-        g_ingameUITextures.lettersSurf[1] = g_ingameUITextures.lettersSurf[0];
-    }
+    ResourceHandle letters[2], lettersMasks[2];
+    letters[0] = uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_lettersPull, &lettersMasks[0]);
+    letters[1] = uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_lettersPulled, &lettersMasks[1]);
+    setLetters(letters, lettersMasks);
 
     // Power UI
-    if (g_loadedSurfaces.ingame_powerBg) {
-        g_ingameUITextures.powerUI_bg = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_powerBg);
-        SDL_FreeSurface(g_loadedSurfaces.ingame_powerBg);
-    }
+    g_ingameUITextures.powerUI_bg =
+            resourceGetTexture(uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_powerBg, NULL));
 
     for (int i = 0; i < 9; i++) {
-        if (g_loadedSurfaces.ingame_powerBoxes[i]) {
-            g_ingameUITextures.powerUI_boxSurfs[i] = g_loadedSurfaces.ingame_powerBoxes[i]; // Keep surface
-            g_ingameUITextures.powerUI_boxes[i] = SDL_CreateTextureFromSurface(renderer, g_loadedSurfaces.ingame_powerBoxes[i]);
-        }
+        g_ingameUITextures.powerUI_boxes[i] = resourceGetTexture(
+            uploadSurface(renderer, &g_ingameOwned, g_loadedSurfaces.ingame_powerBoxes[i], &mask));
+        g_ingameUITextures.powerUI_boxMasks[i] = resourceGetHitMask(mask);
     }
 
+    //the decoded surfaces aren't needed once uploaded
+    memset(&g_loadedSurfaces, 0, sizeof(g_loadedSurfaces));
+    resourceCollect();
+
     SDL_AtomicSet(&g_texturesCreated, 1);
     return true;
 }
@@ -465,4 +466,4 @@ bool textureManagerSurfacesLoaded(void) {
 
 bool textureManagerIsFullyLoaded(void) {
     return SDL_AtomicGet(&g_texturesCreated) == 1;
-}
\ No newline at end of file
+}
@@ -3,27 +3,29 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
+#include "resource_registry.h"
 
-//main menu textures
+//main menu textures, every pointer is owned by the resource registry and stays valid until its screen is destroyed
 typedef struct {
     SDL_Texture *background;
     SDL_Texture *start;
     SDL_Texture *startHover;
-    SDL_Surface *startSurface;
+    const HitMask *startMask;
     SDL_Texture *about;
     SDL_Texture *aboutHover;
-    SDL_Surface *aboutSurface;
+    const HitMask *aboutMask;
 } MainMenuTextures;
 
 typedef struct {
     SDL_Texture *frames[180];
+    SDL_Texture *framesLow[90]; //every second frame at half the width and height, for when frames run over budget
     SDL_Texture *livesTextures[7];
     SDL_Texture *pauseTex;
     SDL_Texture *lettersTex[2];
-    SDL_Surface *lettersSurf[2];
+    const HitMask *lettersMask[2];
     SDL_Texture *powerUI_bg;
     SDL_Texture *powerUI_boxes[9];
-    SDL_Surface *powerUI_boxSurfs[9];
+    const HitMask *powerUI_boxMasks[9];
 } IngameUITextures;
 
 typedef struct {
@@ -5,14 +5,51 @@
 #include <stdlib.h>
 #include <string.h>
 #include "../game/hangman.h"
+#include "../game/corpus_watcher.h"
 #include "../utility/utilities.h"
 #include "graphics/texture_manager.h"
+#include "graphics/bitmap_font.h"
+#include "graphics/font_manager.h"
+#include "../profiling/alloc_tracker.h"
+#include "../profiling/input_latency.h"
 
 #define FRAME_COUNT 180
 #define FRAME_FPS 30.0f
 #define MAX_LIVES 6
 #define POWER_BOX_SIZE 128
+#define DRAWER_TEXT_SCALE 0.95f
+#define POWER_RESULT_TEXT_SCALE 1.5f
+
+//the animation quality governor steps down after the average cost of a drawn frame, clear to present, stayed over
+//budget for DEGRADE_AFTER_MS, and back up after it stayed under for RESTORE_AFTER_MS
+#define FRAME_BUDGET_MS (1000.0f / 60.0f)
+#define OVER_BUDGET (FRAME_BUDGET_MS * 1.2f)
+#define UNDER_BUDGET (FRAME_BUDGET_MS * 1.05f)
+#define DEGRADE_AFTER_MS 500
+#define RESTORE_AFTER_MS 3000
+
+//each level saves more than the one before it
+typedef enum {
+    QUALITY_FULL,
+    QUALITY_HALF_RATE,  //frames where only the background moved are drawn every second time
+    QUALITY_THIRD_RATE, //every third time
+    QUALITY_LOW_RES,    //every third time, from the half resolution frames
+    QUALITY_FROZEN,     //the background stops, frames are drawn when something else changed and every 30th time
+    QUALITY_LEVELS
+} AnimationQuality;
+
+//a frozen screen still draws now and then, otherwise the governor would never see a frame to restore on
+static const int qualityStride[QUALITY_LEVELS] = {1, 2, 3, 3, 30};
+
+//text rasterized once in white and reused every frame until invalidated, color mod tints the shadow and fill
+typedef struct {
+    SDL_Texture *text;
+    SDL_Color color;
+    bool shadow;
+    SDL_Rect dst;
+} CachedText;
 
+//game side of the screen, only touched by the thread handling input
 typedef struct {
     int frameCount;
     int currentFrame;
@@ -20,9 +57,11 @@ typedef struct {
     float accumulator;
 
     int winW, winH;
+    SDL_Window *window;
 
     GameState *game;
-    TTF_Font *font;
+    WordScheduler *words; //next rounds take their word from here
+    unsigned int round;
 
     bool paused;
     bool lettersPulled;
@@ -38,21 +77,53 @@ typedef struct {
     bool showPowerResult;
     char powerResultText[256];
     float powerResultTimer;
+
+    Uint64 revealKeyTime; //stamp of the key press that last changed the revealed word
 } IngameUI;
 
+//render side of the screen, fonts and textures only touched by the thread that renders
+typedef struct {
+    bool loaded;
+    int winW, winH;
+    TTF_Font *font;
+
+    //atlases for text that changes from frame to frame
+    BitmapFont drawerFont;
+    BitmapFont resultFont;
+
+    //retained text, rebuilt only when the round, game version or window size changes
+    CachedText revealedText;
+    CachedText hintText;
+    CachedText titleText;
+    CachedText escText;
+    CachedText enterText;
+    bool textCacheValid;
+    unsigned int textCacheRound;
+    unsigned int textCacheVersion;
+    int textCacheW, textCacheH;
+
+    //animation quality governor, fed with the cost of every drawn frame
+    AnimationQuality quality;
+    Uint64 drawStart;           //when the frame being drawn was cleared, 0 if none is
+    float frameMs;              //moving average
+    Uint32 overTime, underTime; //when the average went over or under budget, 0 while it isn't
+    int skipped;                //renders skipped since the last frame drawn
+    int frozenFrame;
+
+    //what the last drawn frame showed besides the background
+    bool drawnValid;
+    IngameSnapshot drawn;
+} IngameView;
+
 static IngameUI ui;
+static IngameView view;
 
-//HELPER METHODS:
+//never reset, so a new game can't be mistaken for the one the view still has text cached for
+static unsigned int rounds = 0;
 
-static bool surfacePixelOpaque(SDL_Surface *surf, int x, int y) {
-    if (!surf) return false;
-    if (x < 0 || y < 0 || x >= surf->w || y >= surf->h) return false;
-    Uint32 *pixels = (Uint32 *) surf->pixels;
-    Uint32 pixel = pixels[y * surf->w + x];
-    Uint8 r, g, b, a;
-    SDL_GetRGBA(pixel, surf->format, &r, &g, &b, &a);
-    return a > 0;
-}
+static bool governorEnabled = true;
+
+//HELPER METHODS:
 
 static void mapMouseToSurface(int mouseX, int mouseY, int winW, int winH, int surfW, int surfH, int *outX,
                                  int *outY) {
@@ -68,101 +139,77 @@ static void mapMouseToSurface(int mouseX, int mouseY, int winW, int winH, int su
 
 //TEXT RENDERING:
 
-static void renderTextScaledWithShadow(SDL_Renderer *renderer, TTF_Font *font, const char *text,
-                                           int x, int y, SDL_Color color, float scale) {
+/**
+ * Rasterizes text once as a white mask, every draw tints it with SDL_SetTextureColorMod
+ *
+ * @return the texture, NULL if the font couldn't rasterize it
+ */
+static SDL_Texture *rasterizeTextMask(SDL_Renderer *renderer, TTF_Font *font, const char *text) {
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface *surf = TTF_RenderText_Blended(font, text, white);
+    if (!surf) return NULL;
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surf);
+    SDL_FreeSurface(surf);
+    return texture;
+}
+
+//rasterizes text once, the shadow is the same texture tinted black. The caller decides when to rebuild it
+static void buildTextScaledWithShadow(SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                                      int x, int y, SDL_Color color, float scale, CachedText *out) {
     if (!text || !font) return;
     int baseSize = TTF_FontHeight(font);
     int newSize = (int) (baseSize * scale);
     if (newSize < 4) newSize = 4;
-    TTF_Font *scaledFont = TTF_OpenFont("resources/font/MotaPixel-Bold.otf", newSize);
+    TTF_Font *scaledFont = fontManagerGet(FONT_MOTA_PIXEL_BOLD, newSize);
     if (!scaledFont) return;
 
-    SDL_Color shadowColor = {0, 0, 0, 255};
-    SDL_Surface *surf = TTF_RenderText_Blended(scaledFont, text, shadowColor);
-    if (!surf) {
-        TTF_CloseFont(scaledFont);
-        return;
-    }
-    SDL_Texture *shadowTex = SDL_CreateTextureFromSurface(renderer, surf);
-    SDL_FreeSurface(surf);
+    out->text = rasterizeTextMask(renderer, scaledFont, text);
+    if (!out->text) return;
+    out->color = color;
+    out->shadow = true;
+    out->dst.x = x;
+    out->dst.y = y;
+    SDL_QueryTexture(out->text, NULL, NULL, &out->dst.w, &out->dst.h);
+}
 
-    surf = TTF_RenderText_Blended(scaledFont, text, color);
-    SDL_Texture *mainTex = SDL_CreateTextureFromSurface(renderer, surf);
-    SDL_FreeSurface(surf);
+static void drawCachedText(SDL_Renderer *renderer, const CachedText *cached) {
+    if (!cached->text) return;
+    if (cached->shadow) {
+        SDL_Rect shadowDst = cached->dst;
+        shadowDst.x += 2;
+        shadowDst.y += 2;
+        SDL_SetTextureColorMod(cached->text, 0, 0, 0);
+        SDL_SetTextureAlphaMod(cached->text, 255);
+        SDL_RenderCopy(renderer, cached->text, NULL, &shadowDst);
+    }
+    SDL_SetTextureColorMod(cached->text, cached->color.r, cached->color.g, cached->color.b);
+    SDL_SetTextureAlphaMod(cached->text, cached->color.a);
+    SDL_RenderCopy(renderer, cached->text, NULL, &cached->dst);
+}
 
-    SDL_Rect dst;
-    dst.x = x;
-    dst.y = y;
-    SDL_QueryTexture(mainTex, NULL, NULL, &dst.w, &dst.h);
-
-    SDL_Rect shadowDst = dst;
-    shadowDst.x += 2;
-    shadowDst.y += 2;
-    SDL_RenderCopy(renderer, shadowTex, NULL, &shadowDst);
-    SDL_RenderCopy(renderer, mainTex, NULL, &dst);
-
-    SDL_DestroyTexture(shadowTex);
-    SDL_DestroyTexture(mainTex);
-    TTF_CloseFont(scaledFont);
+static void freeCachedText(CachedText *cached) {
+    if (cached->text) SDL_DestroyTexture(cached->text);
+    memset(cached, 0, sizeof(CachedText));
 }
 
-// POWER UP WRAPPER FOR UI BASED
-
-void ingameUiActivatePowerup(GameState *game, int power_id, char *outMessage, size_t size) {
-    if (!game || !outMessage || size == 0) return;
-    outMessage[0] = 0;
-    char buffer[256] = {0};
-
-    switch (power_id) {
-        case 1: {
-            int len = strlen(game->word);
-            int validIndexes[MAX_WORD_LEN];
-            int count = 0;
-            for (int i = 0; i < len; i++) if (game->revealed[i] == '_') validIndexes[count++] = i;
-            if (count > 0) {
-                int idx = validIndexes[rand() % count];
-                game->revealed[idx] = game->word[idx];
-                snprintf(buffer, sizeof(buffer), "Power-Up: A random letter was revealed!");
-            } else snprintf(buffer, sizeof(buffer), "Nothing happened.");
-        }
-        break;
-        case 2: game->lives++;
-            snprintf(buffer, sizeof(buffer), "Power-Up: +1 Life!");
-            break;
-        case 3: for (int i = 0; game->word[i]; i++) {
-                char c = game->word[i];
-                if (c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u')game->revealed[i] = c;
-            }
-            snprintf(buffer, sizeof(buffer), "Power-Up: All vowels revealed!");
-            break;
-        case 4: game->shieldActive = 1;
-            snprintf(buffer, sizeof(buffer), "Power-Up: Shield activated!");
-            break;
-        case 5: {
-            int roll = rand() % 100 + 1;
-            if (roll <= 5) {
-                int pid = rand() % 4 + 1;
-                char submsg[128];
-                ingameUiActivatePowerup(game, pid, submsg, sizeof(submsg));
-                snprintf(buffer, sizeof(buffer), "Bonus random power up!\n%s", submsg);
-            } else if (roll <= 10) {
-                game->lives--;
-                snprintf(buffer, sizeof(buffer), "Lost 1 life.");
-            } else {
-                snprintf(buffer, sizeof(buffer), "No power-up was obtained.");
-            }
-        }
-        break;
-        default: snprintf(buffer, sizeof(buffer), "Empty Box...");
+//opens a box, the game logic is shared with the terminal and server, only the wording on screen is the UI's
+static void openPowerBox(int power_id) {
+    applyPowerUp(ui.game, power_id, hangmanRand, NULL, ui.powerResultText, sizeof(ui.powerResultText));
+    size_t length = strlen(ui.powerResultText);
+    if (length > 0 && ui.powerResultText[length - 1] == '\n') ui.powerResultText[--length] = 0;
+    if (length == 0) {
+        snprintf(ui.powerResultText, sizeof(ui.powerResultText), "%s",
+                 power_id >= 1 && power_id <= 5 ? "Nothing happened." : "Empty Box...");
     }
-    strncpy(outMessage, buffer, size - 1);
-    outMessage[size - 1] = 0;
 }
 
 //initialise
-bool ingameUiInit(SDL_Window *window, SDL_Renderer *renderer, GameState *game) {
+bool ingameUiInit(SDL_Window *window, GameState *game, WordScheduler *words) {
     memset(&ui, 0, sizeof(ui));
     ui.game = game;
+    ui.words = words;
+    ui.window = window;
+    ui.round = ++rounds;
     SDL_GetWindowSize(window, &ui.winW, &ui.winH);
     ui.frameCount = FRAME_COUNT;
     ui.currentFrame = 0;
@@ -174,9 +221,8 @@ bool ingameUiInit(SDL_Window *window, SDL_Renderer *renderer, GameState *game) {
     ui.quitToMenu = false;
     ui.lettersPulled = false;
 
-    //load font
-    ui.font = TTF_OpenFont("resources/font/PixelifySans-SemiBold.ttf", 36);
-    if (!ui.font) {
+    //fonts are opened by the renderer, every ingame font falls back to this one
+    if (!fontManagerPreload(FONT_FALLBACK)) {
         printf("[ERROR] Failed to load font\n");
         return false;
     }
@@ -202,14 +248,68 @@ void ingameUiTriggerPowerup(void) {
     }
 }
 
+static void invalidateTextCache(void) {
+    freeCachedText(&view.revealedText);
+    freeCachedText(&view.hintText);
+    freeCachedText(&view.titleText);
+    freeCachedText(&view.escText);
+    freeCachedText(&view.enterText);
+    view.textCacheValid = false;
+}
+
 // destroy
 void ingameUiDestroy() {
-    //close font
-    if (ui.font) TTF_CloseFont(ui.font);
+    ui.game = NULL;
+    ui.words = NULL;
+}
+
+//opens the fonts and bakes the atlases the first time the screen is drawn
+static void loadView(SDL_Renderer *renderer) {
+    view.loaded = true;
+    view.font = fontManagerGet(FONT_PIXELIFY_SEMIBOLD, 36);
+    if (!view.font) {
+        printf("[ERROR] Failed to load font\n");
+        return;
+    }
+
+    //bake the sizes the guessed letters drawer and power result text use
+    fontManagerLock();
+    int baseSize = TTF_FontHeight(view.font);
+    fontManagerUnlock();
+    if (!bitmapFontLoad(&view.drawerFont, renderer, FONT_MOTA_PIXEL_BOLD,
+                        (int) (baseSize * DRAWER_TEXT_SCALE)) ||
+        !bitmapFontLoad(&view.resultFont, renderer, FONT_MOTA_PIXEL_BOLD,
+                        (int) (baseSize * POWER_RESULT_TEXT_SCALE))) {
+        printf("[ERROR] Failed to bake ingame font atlases\n");
+    }
+}
+
+void ingameUiReleaseRender(void) {
+    invalidateTextCache();
+    bitmapFontDestroy(&view.drawerFont);
+    bitmapFontDestroy(&view.resultFont);
+
+    //fonts belong to the font manager, the next render starts over at full quality
+    memset(&view, 0, sizeof(view));
+}
+
+void ingameUiSetQualityGovernor(bool enabled) {
+    governorEnabled = enabled;
+    view.quality = QUALITY_FULL;
+}
+
+//the round ends on the first state that lost or won, the next key press decides what comes after it
+static void checkGameOver(void) {
+    if (!ui.game || ui.quitToMenu) return;
+    if (ui.game->lives == 0 || isWordFullyRevealed(ui.game->revealed)) {
+        ui.gameOver = true;
+        ui.waitingAfterGameOver = true;
+    }
 }
 
 //update ui
 void ingameUiUpdate(float deltaTime) {
+    checkGameOver();
     if (ui.paused) return;
     ui.accumulator += deltaTime;
     while (ui.accumulator >= ui.frameTime) {
@@ -223,9 +323,9 @@ void ingameUiUpdate(float deltaTime) {
     }
 }
 
-//handle events
-void ingameUiHandleEvent(SDL_Event *event) {
+static void handleEvent(SDL_Event *event) {
     if (!ui.game) return;
+    SDL_GetWindowSize(ui.window, &ui.winW, &ui.winH);
 
     if (ui.gameOver || ui.waitingAfterGameOver) {
         if (event->type == SDL_KEYDOWN) {
@@ -234,13 +334,17 @@ void ingameUiHandleEvent(SDL_Event *event) {
                 ui.waitingAfterGameOver = false;
                 ui.gameOver = false;
             } else if (event->key.keysym.sym == SDLK_RETURN || event->key.keysym.sym == SDLK_KP_ENTER) {
-                char *newWordFile = getRandomWordFileName();
-                char *newWord = getRandomWordFromFile(newWordFile);
-                if (newWord) {
-                    GameState newGame = resetGame(newWordFile, newWord, MAX_LIVES);
-                    free(newWord);
-                    *(ui.game) = newGame;
+                //the next round is set up in place, straight from the corpus when it is loaded
+                if (!wordSchedulerStartGame(ui.words, corpusWatcherGet(), ui.game, MAX_LIVES)) {
+                    char *newWordFile = getRandomWordFileName();
+                    char *newWord = getRandomWordFromFile(newWordFile);
+                    if (newWord) {
+                        initHangmanInPlace(ui.game, newWordFile, newWord, MAX_LIVES);
+                        free(newWord);
+                    }
                 }
+                //new game restarts its version counter, a new round tells the view to drop its cache
+                ui.round = ++rounds;
                 ui.gameOver = false;
                 ui.paused = false;
                 ui.waitingAfterGameOver = false;
@@ -250,11 +354,11 @@ void ingameUiHandleEvent(SDL_Event *event) {
     }
 
     if (event->type == SDL_MOUSEBUTTONDOWN && event->button.button == SDL_BUTTON_LEFT) {
-        SDL_Surface *surf = ui.lettersPulled ? g_ingameUITextures.lettersSurf[1] : g_ingameUITextures.lettersSurf[0];
-        if (surf) {
+        const HitMask *mask = ui.lettersPulled ? g_ingameUITextures.lettersMask[1] : g_ingameUITextures.lettersMask[0];
+        if (mask) {
             int sx, sy;
-            mapMouseToSurface(event->button.x, event->button.y, ui.winW, ui.winH, surf->w, surf->h, &sx, &sy);
-            if (surfacePixelOpaque(surf, sx, sy)) {
+            mapMouseToSurface(event->button.x, event->button.y, ui.winW, ui.winH, mask->w, mask->h, &sx, &sy);
+            if (hitMaskTest(mask, sx, sy)) {
                 ui.lettersPulled = !ui.lettersPulled;
                 return;
             }
@@ -290,13 +394,13 @@ void ingameUiHandleEvent(SDL_Event *event) {
         int my = event->button.y;
 
         for (int i = 0; i < 9; i++) {
-            SDL_Surface *surf = g_ingameUITextures.powerUI_boxSurfs[i];
-            if (surf) {
+            const HitMask *mask = g_ingameUITextures.powerUI_boxMasks[i];
+            if (mask) {
                 int sx, sy;
-                mapMouseToSurface(mx, my, ui.winW, ui.winH, surf->w, surf->h, &sx, &sy);
-                if (surfacePixelOpaque(surf, sx, sy)) {
+                mapMouseToSurface(mx, my, ui.winW, ui.winH, mask->w, mask->h, &sx, &sy);
+                if (hitMaskTest(mask, sx, sy)) {
                     ui.selectedBox = i;
-                    ingameUiActivatePowerup(ui.game, i + 1, ui.powerResultText, sizeof(ui.powerResultText));
+                    openPowerBox(i + 1);
                     ui.showPowerResult = true;
                     ui.powerResultTimer = 3.0f;
                     ui.powerUIActive = false;
@@ -307,162 +411,293 @@ void ingameUiHandleEvent(SDL_Event *event) {
     }
 }
 
-static void renderTextFitted(SDL_Renderer *renderer, const char *text, int boundX, int boundW, int y, float baseScale,
-                               SDL_Color color) {
-    if (!text || !ui.font) return;
+//handle events
+void ingameUiHandleEvent(SDL_Event *event) {
+    //a key press that changes the revealed word is timed until the frame showing it is presented
+    Uint64 keyTime = inputLatencyKeyTime(event);
+    char revealed[MAX_WORD_LEN];
+    if (keyTime && ui.game) memcpy(revealed, ui.game->revealed, sizeof(revealed));
+
+    handleEvent(event);
+
+    if (keyTime && ui.game && memcmp(revealed, ui.game->revealed, sizeof(revealed)) != 0) ui.revealKeyTime = keyTime;
+    checkGameOver();
+}
+
+void ingameUiSnapshot(IngameSnapshot *out, float sinceUpdate) {
+    out->hasGame = ui.game != NULL;
+    if (ui.game) out->game = *ui.game;
+    out->round = ui.round;
+    out->currentFrame = ui.currentFrame;
+    out->accumulator = ui.accumulator;
+    out->paused = ui.paused;
+    out->lettersPulled = ui.lettersPulled;
+    out->powerUIActive = ui.powerUIActive;
+    out->showPowerResult = ui.showPowerResult;
+    out->powerResultTimer = ui.powerResultTimer;
+    memcpy(out->powerResultText, ui.powerResultText, sizeof(out->powerResultText));
+    out->sinceUpdate = sinceUpdate;
+    out->revealKeyTime = ui.revealKeyTime;
+}
+
+static void buildTextFitted(SDL_Renderer *renderer, const char *text, int boundX, int boundW, int y, float baseScale,
+                            SDL_Color color, CachedText *out) {
+    if (!text || !view.font) return;
     int textW, textH;
-    TTF_SizeText(ui.font, text, &textW, &textH);
+    TTF_SizeText(view.font, text, &textW, &textH);
     float finalScale = baseScale;
     float scaledW = textW * finalScale;
     if (scaledW > boundW) {
         finalScale = boundW / (float) textW;
         scaledW = textW * finalScale;
     }
-    int baseSize = TTF_FontHeight(ui.font);
+    int baseSize = TTF_FontHeight(view.font);
     int dynSize = (int) (baseSize * finalScale);
     if (dynSize < 4) dynSize = 4;
-    TTF_Font *f = TTF_OpenFont("resources/font/MotaPixel-Bold.otf", dynSize);
+    TTF_Font *f = fontManagerGet(FONT_MOTA_PIXEL_BOLD, dynSize);
     if (!f) return;
-    SDL_Surface *surf = TTF_RenderText_Blended(f, text, color);
-    TTF_CloseFont(f);
-    if (!surf) return;
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, surf);
-    SDL_FreeSurface(surf);
-    if (!tex) return;
-    SDL_Rect dst;
-    dst.w = (int) scaledW;
-    dst.h = dynSize;
-    dst.x = boundX + (boundW - dst.w) / 2;
-    dst.y = y;
-    SDL_RenderCopy(renderer, tex, NULL, &dst);
-    SDL_DestroyTexture(tex);
+    out->text = rasterizeTextMask(renderer, f, text);
+    if (!out->text) return;
+    out->color = color;
+    out->dst.w = (int) scaledW;
+    out->dst.h = dynSize;
+    out->dst.x = boundX + (boundW - out->dst.w) / 2;
+    out->dst.y = y;
+}
+
+//rebuilds every retained text texture, only called when the game state or window size changed
+static void rebuildTextCache(SDL_Renderer *renderer, const GameState *game, unsigned int round) {
+    invalidateTextCache();
+    //every measure and rasterize below goes through SDL_ttf, which the about layout worker may be using
+    fontManagerLock();
+
+    SDL_Color white = {255, 255, 255, 255};
+
+    //fit revealed word inside the reference area (based on 1080p)
+    float leftPercent = 562.0f / 1920.0f;
+    float rightPercent = 690.0f / 1920.0f;
+    int boundX = (int) (view.winW * leftPercent);
+    int boundW = view.winW - (int) (view.winW * leftPercent) - (int) (view.winW * rightPercent);
+    int y = (int) (view.winH * 0.4);
+
+    buildTextFitted(renderer, game->revealed, boundX, boundW, y, 2.15f, white, &view.revealedText);
+
+    //word category hint
+    int xHint = (int) (view.winW * 0.02f);
+    int yHint = (int) (view.winH * 0.25f);
+    char hintString[256];
+    snprintf(hintString, sizeof(hintString), "Hint: %s", game->wordFile);
+    buildTextScaledWithShadow(renderer, view.font, hintString, xHint, yHint, white, 1.0f, &view.hintText);
+
+    //game over prompts
+    if (game->lives == 0 || isWordFullyRevealed(game->revealed)) {
+        const char *escLine = "[ESC] to quit";
+        const char *enterLine = "[Enter] to play again";
+
+        int textW, textH;
+        int spacing = 8;
+
+        //winning message
+        if (game->lives > 0) {
+            const char *title = "YOU WON";
+            int titleY = (int) (view.winH * 0.10f);
+            TTF_SizeText(view.font, title, &textW, &textH);
+            int centerX = (view.winW - 2 * (textW)) / 2;
+            buildTextScaledWithShadow(renderer, view.font, title, centerX, titleY, white, 2.0f, &view.titleText);
+        } else {
+            char title[256]; //a writable buffer
+            snprintf(title, sizeof(title), "Word was: %s", game->word);
+
+            int titleY = (int) (view.winH * 0.30f);
+            TTF_SizeText(view.font, title, &textW, &textH);
+            int centerX = (view.winW - 2 * textW) / 1.5;
+            buildTextScaledWithShadow(renderer, view.font, title, centerX, titleY, white, 1.5f, &view.titleText);
+        }
+
+        //ESC/ENTER prompts
+        int bottomY = (int) (view.winH * 0.75);
+
+        TTF_SizeText(view.font, escLine, &textW, &textH);
+        int escX = (view.winW - textW) / 2;
+        int escY = bottomY - (textH * 2 + spacing);
+        buildTextScaledWithShadow(renderer, view.font, escLine, escX, escY, white, 1.0f, &view.escText);
+
+        TTF_SizeText(view.font, enterLine, &textW, &textH);
+        int enterX = (view.winW - textW) / 2;
+        int enterY = escY + textH + spacing;
+        buildTextScaledWithShadow(renderer, view.font, enterLine, enterX, enterY, white, 1.0f, &view.enterText);
+    }
+
+    fontManagerUnlock();
+
+    view.textCacheValid = true;
+    view.textCacheRound = round;
+    view.textCacheVersion = game->version;
+    view.textCacheW = view.winW;
+    view.textCacheH = view.winH;
+}
+
+/**
+ * Moves the quality a level down or up once the moving average stayed out of budget long enough. Skipped frames
+ * cost nothing and are never counted, so skipping can't make the average look good enough to restore
+ *
+ * @param ms time from clearing a drawn frame until its present returned
+ */
+static void governQuality(float ms) {
+    if (!governorEnabled) return;
+
+    //first frame since the view was reset, or a stall that says nothing about the frame itself
+    if (view.frameMs <= 0 || ms <= 0 || ms > 1000.0f) {
+        view.frameMs = FRAME_BUDGET_MS;
+        return;
+    }
+    view.frameMs += (ms - view.frameMs) * 0.1f;
+
+    Uint32 ticks = SDL_GetTicks();
+    if (view.frameMs > OVER_BUDGET) {
+        view.underTime = 0;
+        if (!view.overTime) view.overTime = ticks;
+        if (view.quality < QUALITY_FROZEN && ticks - view.overTime >= DEGRADE_AFTER_MS) {
+            view.quality++;
+            view.overTime = ticks;
+        }
+    } else if (view.frameMs < UNDER_BUDGET) {
+        view.overTime = 0;
+        if (!view.underTime) view.underTime = ticks;
+        if (view.quality > QUALITY_FULL && ticks - view.underTime >= RESTORE_AFTER_MS) {
+            view.quality--;
+            view.underTime = ticks;
+        }
+    } else {
+        view.overTime = 0;
+        view.underTime = 0;
+    }
+}
+
+void ingameUiFramePresented(void) {
+    if (!view.drawStart) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    governQuality((float) ((double) (now - view.drawStart) * 1000.0 / SDL_GetPerformanceFrequency()));
+    view.drawStart = 0;
+}
+
+//true if anything but the background animation differs from the last drawn frame
+static bool contentChanged(const IngameSnapshot *snap) {
+    const IngameSnapshot *drawn = &view.drawn;
+    bool resultShown = snap->showPowerResult && snap->powerResultTimer - snap->sinceUpdate > 0;
+    bool resultDrawn = drawn->showPowerResult && drawn->powerResultTimer - drawn->sinceUpdate > 0;
+    return !view.drawnValid || view.textCacheW != view.winW || view.textCacheH != view.winH ||
+           snap->hasGame != drawn->hasGame || snap->round != drawn->round ||
+           snap->game.version != drawn->game.version || snap->game.numGuessed != drawn->game.numGuessed ||
+           snap->paused != drawn->paused || snap->lettersPulled != drawn->lettersPulled ||
+           snap->powerUIActive != drawn->powerUIActive || resultShown != resultDrawn ||
+           snap->revealKeyTime != drawn->revealKeyTime;
 }
 
 //render
-void ingameUiRender(SDL_Renderer *renderer, SDL_Window *window) {
-    SDL_GetWindowSize(window, &ui.winW, &ui.winH);
+bool ingameUiRender(SDL_Renderer *renderer, int winW, int winH, const IngameSnapshot *snap) {
+    if (!view.loaded) loadView(renderer);
+    view.winW = winW;
+    view.winH = winH;
+
+    //under load, frames that would only move the background on are skipped
+    if (!contentChanged(snap)) {
+        view.skipped++;
+        int stride = qualityStride[view.quality];
+        if (!stride || view.skipped < stride) return false;
+    }
+    view.skipped = 0;
+    view.drawn = *snap;
+    view.drawnValid = true;
+
+    view.drawStart = SDL_GetPerformanceCounter();
     SDL_RenderClear(renderer);
 
-    //background frames
-    if (g_ingameUITextures.frames[ui.currentFrame]) {
-        SDL_Rect full = {0, 0, ui.winW, ui.winH};
-        SDL_RenderCopy(renderer, g_ingameUITextures.frames[ui.currentFrame], NULL, &full);
+    //background frames, the part of a tick that hasn't been simulated yet can still move the animation on
+    int frame = snap->currentFrame;
+    if (!snap->paused && snap->sinceUpdate > 0) {
+        frame = (snap->currentFrame + (int) ((snap->accumulator + snap->sinceUpdate) * FRAME_FPS)) % FRAME_COUNT;
+    }
+    if (view.quality == QUALITY_FROZEN) frame = view.frozenFrame;
+    view.frozenFrame = frame;
+
+    SDL_Texture *background = g_ingameUITextures.frames[frame];
+    if (view.quality >= QUALITY_LOW_RES && g_ingameUITextures.framesLow[frame / 2]) {
+        background = g_ingameUITextures.framesLow[frame / 2];
+    }
+    if (background) {
+        SDL_Rect full = {0, 0, view.winW, view.winH};
+        SDL_RenderCopy(renderer, background, NULL, &full);
     }
 
     //lives overlay
-    if (ui.game) {
-        int lives = ui.game->lives;
+    if (snap->hasGame) {
+        const GameState *game = &snap->game;
+        int lives = game->lives;
         if (lives < 0) lives = 0;
         if (lives > MAX_LIVES) lives = MAX_LIVES;
 
         SDL_Texture *livesTex = g_ingameUITextures.livesTextures[lives];
         if (livesTex) {
-            SDL_Rect r = {0, 0, ui.winW, ui.winH};
+            SDL_Rect r = {0, 0, view.winW, view.winH};
             SDL_RenderCopy(renderer, livesTex, NULL, &r);
         }
 
-        SDL_Color white = {255, 255, 255, 255};
-
-        //fit revealed word inside the reference area (based on 1080p)
-        float leftPercent = 562.0f / 1920.0f;
-        float rightPercent = 690.0f / 1920.0f;
-        int boundX = (int) (ui.winW * leftPercent);
-        int boundW = ui.winW - (int) (ui.winW * leftPercent) - (int) (ui.winW * rightPercent);
-        int y = (int) (ui.winH * 0.4);
-
-        renderTextFitted(renderer, ui.game->revealed, boundX, boundW, y, 2.15f, white);
+        if (!view.textCacheValid || view.textCacheRound != snap->round || view.textCacheVersion != game->version ||
+            view.textCacheW != view.winW || view.textCacheH != view.winH) {
+            rebuildTextCache(renderer, game, snap->round);
+        }
 
-        //word category hint
-        int xHint = (int)(ui.winW * 0.02f);
-        int yHint = (int)(ui.winH * 0.25f);
-        char hintString[256] = "Hint: ";
-        snprintf(hintString, sizeof(hintString), "Hint: %s", ui.game->wordFile);
-        renderTextScaledWithShadow(renderer, ui.font, hintString,
-                                       xHint, yHint, white, 1.0f);
+        drawCachedText(renderer, &view.revealedText);
+        drawCachedText(renderer, &view.hintText);
 
         //game over you won message
-        bool gameOver = (ui.game->lives == 0 || isWordFullyRevealed(ui.game->revealed));
+        bool gameOver = (game->lives == 0 || isWordFullyRevealed(game->revealed));
         if (gameOver) {
-            ui.gameOver = true;
-            ui.waitingAfterGameOver = true;
-
-            const char *escLine = "[ESC] to quit";
-            const char *enterLine = "[Enter] to play again";
-
-            int textW, textH;
-            int spacing = 8;
-
-            //winning message
-            if (ui.game->lives > 0) {
-                const char *title = "YOU WON";
-                int titleY = (int) (ui.winH * 0.10f);
-                TTF_SizeText(ui.font, title, &textW, &textH);
-                int centerX = (ui.winW - 2 * (textW)) / 2;
-                renderTextScaledWithShadow(renderer, ui.font, title, centerX, titleY, white, 2.0f);
-            } else {
-                char title[256];  //a writable buffer
-                snprintf(title, sizeof(title), "Word was: %s", ui.game->word);
-
-                int titleY = (int)(ui.winH * 0.30f);
-                TTF_SizeText(ui.font, title, &textW, &textH);
-                int centerX = (ui.winW - 2 * textW) / 1.5;
-                renderTextScaledWithShadow(renderer, ui.font, title, centerX, titleY, white, 1.5f);
-            }
-
-
-            //ESC/ENTER prompts
-            int bottomY = (int) (ui.winH * 0.75);
-
-            TTF_SizeText(ui.font, escLine, &textW, &textH);
-            int escX = (ui.winW - textW) / 2;
-            int escY = bottomY - (textH * 2 + spacing);
-            renderTextScaledWithShadow(renderer, ui.font, escLine, escX, escY, white, 1.0f);
-
-            TTF_SizeText(ui.font, enterLine, &textW, &textH);
-            int enterX = (ui.winW - textW) / 2;
-            int enterY = escY + textH + spacing;
-            renderTextScaledWithShadow(renderer, ui.font, enterLine, enterX, enterY, white, 1.0f);
+            drawCachedText(renderer, &view.titleText);
+            drawCachedText(renderer, &view.escText);
+            drawCachedText(renderer, &view.enterText);
         }
     }
 
     //letters used button
-    SDL_Texture *buttonTex = ui.lettersPulled ? g_ingameUITextures.lettersTex[1] : g_ingameUITextures.lettersTex[0];
+    SDL_Texture *buttonTex = snap->lettersPulled ? g_ingameUITextures.lettersTex[1] : g_ingameUITextures.lettersTex[0];
     if (buttonTex) {
-        SDL_Rect full = {0, 0, ui.winW, ui.winH};
+        SDL_Rect full = {0, 0, view.winW, view.winH};
         SDL_RenderCopy(renderer, buttonTex, NULL, &full);
     }
 
     //guessed letters
-    if (ui.lettersPulled && ui.game) {
+    if (snap->lettersPulled && snap->hasGame) {
         SDL_Color white = {255, 255, 255, 255};
 
-        int boundX = (int) (ui.winW * (1580.0f / 1920.0f));
-        int boundW = ui.winW - boundX;
-        int boundY = (int) (ui.winH * (218.0f / 1080.0f));
+        int boundX = (int) (view.winW * (1580.0f / 1920.0f));
+        int boundW = view.winW - boundX;
+        int boundY = (int) (view.winH * (218.0f / 1080.0f));
 
         int textW, textH;
-        TTF_SizeText(ui.font, "guessed:", &textW, &textH);
+        bitmapFontMeasure(&view.drawerFont, "guessed:", &textW, &textH);
         int centerX = boundX + (boundW - textW) / 2;
-        renderTextScaledWithShadow(renderer, ui.font, "guessed:", centerX, boundY, white, 0.95f);
+        bitmapFontDrawWithShadow(renderer, &view.drawerFont, "guessed:", centerX, boundY, white);
 
         char line[1024] = {0};
         int lineLen = 0;
         int yOffset = textH + 4;
         int curY = boundY + yOffset;
 
-        for (int i = 0; i < ui.game->numGuessed; ++i) {
-            char c = ui.game->guessed[i];
+        for (int i = 0; i < snap->game.numGuessed; ++i) {
+            char c = snap->game.guessed[i];
             char buffer[8];
-            snprintf(buffer, sizeof(buffer), "%c%s", c, (i < ui.game->numGuessed - 1) ? ", " : "");
+            snprintf(buffer, sizeof(buffer), "%c%s", c, (i < snap->game.numGuessed - 1) ? ", " : "");
 
             char tempLine[1024];
             snprintf(tempLine, sizeof(tempLine), "%s%s", line, buffer);
 
-            TTF_SizeText(ui.font, tempLine, &textW, &textH);
+            bitmapFontMeasure(&view.drawerFont, tempLine, &textW, &textH);
             if (textW > boundW && lineLen > 0) {
-                TTF_SizeText(ui.font, line, &textW, &textH);
+                bitmapFontMeasure(&view.drawerFont, line, &textW, &textH);
                 centerX = boundX + (boundW - textW) / 2;
-                renderTextScaledWithShadow(renderer, ui.font, line, centerX, curY, white, 0.95f);
+                bitmapFontDrawWithShadow(renderer, &view.drawerFont, line, centerX, curY, white);
                 curY += textH + 2;
                 snprintf(line, sizeof(line), "%s", buffer);
                 lineLen = strlen(buffer);
@@ -473,23 +708,23 @@ void ingameUiRender(SDL_Renderer *renderer, SDL_Window *window) {
         }
 
         if (lineLen > 0) {
-            TTF_SizeText(ui.font, line, &textW, &textH);
+            bitmapFontMeasure(&view.drawerFont, line, &textW, &textH);
             centerX = boundX + (boundW - textW) / 2;
-            renderTextScaledWithShadow(renderer, ui.font, line, centerX, curY, white, 0.95f);
+            bitmapFontDrawWithShadow(renderer, &view.drawerFont, line, centerX, curY, white);
         }
     }
 
     //pause overlay
-    if (ui.paused && g_ingameUITextures.pauseTex) {
-        SDL_Rect full = {0, 0, ui.winW, ui.winH};
+    if (snap->paused && g_ingameUITextures.pauseTex) {
+        SDL_Rect full = {0, 0, view.winW, view.winH};
         SDL_RenderCopy(renderer, g_ingameUITextures.pauseTex, NULL, &full);
     }
 
     //power ui
-    if (ui.powerUIActive) {
+    if (snap->powerUIActive) {
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150);
-        SDL_Rect full = {0, 0, ui.winW, ui.winH};
+        SDL_Rect full = {0, 0, view.winW, view.winH};
         SDL_RenderFillRect(renderer, &full);
 
         if (g_ingameUITextures.powerUI_bg) SDL_RenderCopy(renderer, g_ingameUITextures.powerUI_bg, NULL, &full);
@@ -500,24 +735,23 @@ void ingameUiRender(SDL_Renderer *renderer, SDL_Window *window) {
         }
     }
 
-    //power result text
-    if (ui.showPowerResult) {
+    //power result text, hidden as soon as its timer would have run out
+    if (snap->showPowerResult && snap->powerResultTimer - snap->sinceUpdate > 0) {
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 100);
-        SDL_Rect full = {0, 0, ui.winW, ui.winH};
+        SDL_Rect full = {0, 0, view.winW, view.winH};
         SDL_RenderFillRect(renderer, &full);
 
         SDL_Color white = {255, 255, 255, 255};
 
         int textW, textH;
-        if (TTF_SizeText(ui.font, ui.powerResultText, &textW, &textH) == 0) {
-            int x = (ui.winW - textW) / 2;
-            int y = (ui.winH - textH) / 2;
-            renderTextScaledWithShadow(renderer, ui.font, ui.powerResultText, x, y, white, 1.5f);
-        }
+        bitmapFontMeasure(&view.resultFont, snap->powerResultText, &textW, &textH);
+        int x = (view.winW - textW) / 2;
+        int y = (view.winH - textH) / 2;
+        bitmapFontDrawWithShadow(renderer, &view.resultFont, snap->powerResultText, x, y, white);
     }
 
-    SDL_RenderPresent(renderer);
+    return true;
 }
 
 bool ingameUiIsWaitingAfterGameover(void) {
@@ -532,6 +766,10 @@ bool ingameUiShouldQuit(void) {
     return ui.quitToMenu;
 }
 
+unsigned int ingameUiRound(void) {
+    return ui.round;
+}
+
 void setShouldQuit(bool b) {
     ui.quitToMenu = b;
 }
\ No newline at end of file
@@ -4,17 +4,52 @@
 #include <SDL2/SDL.h>
 #include <stdbool.h>
 #include "../game/hangman.h"
+#include "../game/word_scheduler.h"
 
-bool ingameUiInit(SDL_Window *window, SDL_Renderer *renderer, GameState *game);
+//everything ingameUiRender draws, copied out of the live state so it can be drawn on another thread
+typedef struct {
+    bool hasGame;
+    GameState game;
+    unsigned int round; //changes with every new word, the game version restarts with it
+    int currentFrame;
+    float accumulator;  //time already spent on the current animation frame
+    bool paused;
+    bool lettersPulled;
+    bool powerUIActive;
+    bool showPowerResult;
+    float powerResultTimer;
+    char powerResultText[256];
+    float sinceUpdate;  //time after the last update, the animation frame and result timer are drawn that far ahead
+    Uint64 revealKeyTime; //key press that last changed the revealed word, see inputLatencyKeyTime
+} IngameSnapshot;
+
+bool ingameUiInit(SDL_Window *window, GameState *game, WordScheduler *words);
 
 void ingameUiDestroy();
 
+//advances animation and timers, main.c calls it at a fixed tick
 void ingameUiUpdate(float deltaTime);
 
-void ingameUiRender(SDL_Renderer *renderer, SDL_Window *window);
+void ingameUiSnapshot(IngameSnapshot *out, float sinceUpdate);
+
+//the only functions touching the renderer, called by whichever thread renders. The caller presents the frame,
+//unless it returns false: under load, frames that would only move the background animation are skipped
+bool ingameUiRender(SDL_Renderer *renderer, int winW, int winH, const IngameSnapshot *snap);
+
+//drops the fonts and textures the screen rendered with, they are made again on the next render
+void ingameUiReleaseRender(void);
+
+//call after presenting a frame ingameUiRender drew, feeds its cost to the quality governor
+void ingameUiFramePresented(void);
+
+//on by default, off draws every frame at full quality whatever the frame time
+void ingameUiSetQualityGovernor(bool enabled);
 
 void ingameUiHandleEvent(SDL_Event *event);
 
+//opens the power up boxes, normally after a guess hit the super blank
+void ingameUiTriggerPowerup(void);
+
 bool ingameUiIsWaitingAfterGameover(void);
 
 bool ingameUiIsGameOver(void);
@@ -23,4 +58,7 @@ void setShouldQuit(bool b);
 
 bool ingameUiShouldQuit(void);
 
+//changes with every new word, together with the game version it tells whether the game changed
+unsigned int ingameUiRound(void);
+
 #endif
\ No newline at end of file
@@ -1,45 +1,70 @@
 #include "loading_screen.h"
-#include <SDL2/SDL_ttf.h>
 #include <stdio.h>
+#include "graphics/bitmap_font.h"
+#include "graphics/font_manager.h"
 
-static TTF_Font *g_loadingFont = NULL;
+#define LOADING_LABEL "Loading..."
+
+static BitmapFont g_loadingFont;
 static SDL_Color g_textColor = {255, 255, 255, 255};
 
+//text never changes beyond these 101 percentages, so strings and widths are computed once
+static char g_percentTexts[101][8];
+static int g_percentWidths[101];
+static int g_labelWidth = 0;
+
+//what is currently on screen, used to skip frames where nothing changed
+static int g_shownPercent = -1;
+static int g_shownW = 0, g_shownH = 0;
+
 bool loadingScreenInit(SDL_Window *window, SDL_Renderer *renderer) {
-    //load a font for "Loading..." text
-    g_loadingFont = TTF_OpenFont("resources/font/PixelifySans-Bold.ttf", 48);
-    if (!g_loadingFont) {
-        printf("[WARNING] Failed to load font for loading screen: %s\n", TTF_GetError());
+    //bake a font atlas for "Loading..." and the percentage text
+    if (!bitmapFontLoad(&g_loadingFont, renderer, FONT_PIXELIFY_BOLD, 48)) {
+        printf("[WARNING] Failed to load font for loading screen\n");
         //continue anyway, we can still show progress bar
     }
+
+    for (int i = 0; i <= 100; i++) {
+        snprintf(g_percentTexts[i], sizeof(g_percentTexts[i]), "%d%%", i);
+        g_percentWidths[i] = 0;
+        if (bitmapFontIsLoaded(&g_loadingFont)) {
+            bitmapFontMeasure(&g_loadingFont, g_percentTexts[i], &g_percentWidths[i], NULL);
+        }
+    }
+    if (bitmapFontIsLoaded(&g_loadingFont)) {
+        bitmapFontMeasure(&g_loadingFont, LOADING_LABEL, &g_labelWidth, NULL);
+    }
+
+    loadingScreenInvalidate();
     return true;
 }
 
+void loadingScreenInvalidate(void) {
+    g_shownPercent = -1;
+}
+
 void loadingScreenRender(SDL_Renderer *renderer, SDL_Window *window, float progress) {
     int windowW, windowH;
     SDL_GetWindowSize(window, &windowW, &windowH);
 
+    int percent = (int) (progress * 100.0f + 0.5f);
+    if (percent < 0) percent = 0;
+    if (percent > 100) percent = 100;
+
+    //nothing visible changed since the last present, leave the frame on screen
+    if (percent == g_shownPercent && windowW == g_shownW && windowH == g_shownH) return;
+    g_shownPercent = percent;
+    g_shownW = windowW;
+    g_shownH = windowH;
+
     // Clear to dark background
     SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
     SDL_RenderClear(renderer);
 
     //draw "Loading..." text
-    if (g_loadingFont) {
-        SDL_Surface *textSurf = TTF_RenderText_Blended(g_loadingFont, "Loading...", g_textColor);
-        if (textSurf) {
-            SDL_Texture *textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-            if (textTex) {
-                SDL_Rect textRect = {
-                    windowW / 2 - textSurf->w / 2,
-                    windowH / 2 - 80,
-                    textSurf->w,
-                    textSurf->h
-                };
-                SDL_RenderCopy(renderer, textTex, NULL, &textRect);
-                SDL_DestroyTexture(textTex);
-            }
-            SDL_FreeSurface(textSurf);
-        }
+    if (bitmapFontIsLoaded(&g_loadingFont)) {
+        bitmapFontDraw(renderer, &g_loadingFont, LOADING_LABEL, windowW / 2 - g_labelWidth / 2, windowH / 2 - 80,
+                       g_textColor);
     }
 
     //draw progress bar background
@@ -53,11 +78,11 @@ void loadingScreenRender(SDL_Renderer *renderer, SDL_Window *window, float progr
     SDL_RenderFillRect(renderer, &barBg);
 
     //draw progress bar fill
-    if (progress > 0.0f) {
+    if (percent > 0) {
         SDL_Rect barFill = {
             windowW / 2 - 200,
             windowH / 2,
-            (int)(400 * progress),
+            4 * percent,
             30
         };
         SDL_SetRenderDrawColor(renderer, 100, 200, 100, 255);
@@ -65,33 +90,14 @@ void loadingScreenRender(SDL_Renderer *renderer, SDL_Window *window, float progr
     }
 
     //draw percentage text
-    if (g_loadingFont) {
-        char percentText[32];
-        snprintf(percentText, sizeof(percentText), "%.0f%%", progress * 100.0f);
-        
-        SDL_Surface *percentSurf = TTF_RenderText_Blended(g_loadingFont, percentText, g_textColor);
-        if (percentSurf) {
-            SDL_Texture *percentTex = SDL_CreateTextureFromSurface(renderer, percentSurf);
-            if (percentTex) {
-                SDL_Rect percentRect = {
-                    windowW / 2 - percentSurf->w / 2,
-                    windowH / 2 + 50,
-                    percentSurf->w,
-                    percentSurf->h
-                };
-                SDL_RenderCopy(renderer, percentTex, NULL, &percentRect);
-                SDL_DestroyTexture(percentTex);
-            }
-            SDL_FreeSurface(percentSurf);
-        }
+    if (bitmapFontIsLoaded(&g_loadingFont)) {
+        bitmapFontDraw(renderer, &g_loadingFont, g_percentTexts[percent], windowW / 2 - g_percentWidths[percent] / 2,
+                       windowH / 2 + 50, g_textColor);
     }
 
     SDL_RenderPresent(renderer);
 }
 
 void loadingScreenDestroy(void) {
-    if (g_loadingFont) {
-        TTF_CloseFont(g_loadingFont);
-        g_loadingFont = NULL;
-    }
+    bitmapFontDestroy(&g_loadingFont);
 }
\ No newline at end of file
@@ -6,8 +6,12 @@
 
 bool loadingScreenInit(SDL_Window *window, SDL_Renderer *renderer);
 
+//only redraws and presents when the shown percentage or window size changed
 void loadingScreenRender(SDL_Renderer *renderer, SDL_Window *window, float progress);
 
+//forces the next loadingScreenRender to redraw, e.g. after the window was exposed
+void loadingScreenInvalidate(void);
+
 void loadingScreenDestroy(void);
 
 #endif
\ No newline at end of file
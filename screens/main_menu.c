@@ -12,19 +12,8 @@ typedef struct {
 static MainMenu menu;
 
 //check if mouse hovers over image, pixel perfect
-static bool isMouseOver(SDL_Surface *surf, int mouseX, int mouseY) {
-    if (!surf) return false;
-
-    if (mouseX < 0 || mouseY < 0 || mouseX >= surf->w || mouseY >= surf->h)
-        return false;
-
-    Uint32 *pixels = (Uint32 *) surf->pixels;
-    Uint32 pixel = pixels[mouseY * surf->w + mouseX];
-
-    Uint8 r, g, b, a;
-    SDL_GetRGBA(pixel, surf->format, &r, &g, &b, &a);
-
-    return a > 0;
+static bool isMouseOver(const HitMask *mask, int mouseX, int mouseY) {
+    return hitMaskTest(mask, mouseX, mouseY);
 }
 
 //maps mouse coordinates to image relative to 1080p
@@ -58,6 +47,9 @@ void mainMenuDestroy() {
 
 //handle events
 MenuAction mainMenuHandleEvent(SDL_Window *window, SDL_Renderer *renderer, SDL_Event *e) {
+    //update window size when user resizes screen and inside another menu
+    SDL_GetWindowSize(window, &menu.winW, &menu.winH);
+
     if (e->type == SDL_MOUSEMOTION) {
         int mx = e->motion.x;
         int my = e->motion.y;
@@ -65,9 +57,9 @@ MenuAction mainMenuHandleEvent(SDL_Window *window, SDL_Renderer *renderer, SDL_E
     }
 
     if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button == SDL_BUTTON_LEFT) {
-        if (isMouseOver(g_mainMenuTextures.startSurface, menu.mouseX, menu.mouseY))
+        if (isMouseOver(g_mainMenuTextures.startMask, menu.mouseX, menu.mouseY))
             return MENU_START;
-        if (isMouseOver(g_mainMenuTextures.aboutSurface, menu.mouseX, menu.mouseY))
+        if (isMouseOver(g_mainMenuTextures.aboutMask, menu.mouseX, menu.mouseY))
             return MENU_ABOUT;
     }
 
@@ -79,26 +71,26 @@ MenuAction mainMenuHandleEvent(SDL_Window *window, SDL_Renderer *renderer, SDL_E
     return MENU_NONE;
 }
 
+void mainMenuSnapshot(MenuSnapshot *out) {
+    out->mouseX = menu.mouseX;
+    out->mouseY = menu.mouseY;
+}
+
 //render main menu
-void mainMenuRender(SDL_Renderer *renderer, SDL_Window *window) {
+void mainMenuRender(SDL_Renderer *renderer, int winW, int winH, const MenuSnapshot *snap) {
     SDL_RenderClear(renderer);
 
-    //update window size when user resizes screen and inside another menu
-    SDL_GetWindowSize(window, &menu.winW, &menu.winH);
-
     //stretch images to fill the window
-    SDL_Rect fullWin = {0, 0, menu.winW, menu.winH};
+    SDL_Rect fullWin = {0, 0, winW, winH};
     SDL_RenderCopy(renderer, g_mainMenuTextures.background, NULL, &fullWin);
 
-    if (isMouseOver(g_mainMenuTextures.startSurface, menu.mouseX, menu.mouseY))
+    if (isMouseOver(g_mainMenuTextures.startMask, snap->mouseX, snap->mouseY))
         SDL_RenderCopy(renderer, g_mainMenuTextures.startHover, NULL, &fullWin);
     else
         SDL_RenderCopy(renderer, g_mainMenuTextures.start, NULL, &fullWin);
 
-    if (isMouseOver(g_mainMenuTextures.aboutSurface, menu.mouseX, menu.mouseY))
+    if (isMouseOver(g_mainMenuTextures.aboutMask, snap->mouseX, snap->mouseY))
         SDL_RenderCopy(renderer, g_mainMenuTextures.aboutHover, NULL, &fullWin);
     else
         SDL_RenderCopy(renderer, g_mainMenuTextures.about, NULL, &fullWin);
-
-    SDL_RenderPresent(renderer);
 }
@@ -10,12 +10,20 @@ typedef enum {
     MENU_ABOUT
 } MenuAction;
 
+//hover state the menu is drawn with, in 1080p image coordinates
+typedef struct {
+    int mouseX, mouseY;
+} MenuSnapshot;
+
 bool mainMenuInit(SDL_Window *window, SDL_Renderer *renderer);
 
 void mainMenuDestroy();
 
 MenuAction mainMenuHandleEvent(SDL_Window *window, SDL_Renderer *renderer, SDL_Event *e);
 
-void mainMenuRender(SDL_Renderer *renderer, SDL_Window *window);
+void mainMenuSnapshot(MenuSnapshot *out);
+
+//draws the menu, the caller presents the frame
+void mainMenuRender(SDL_Renderer *renderer, int winW, int winH, const MenuSnapshot *snap);
 
 #endif
\ No newline at end of file
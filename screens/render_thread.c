@@ -0,0 +1,197 @@
+#include "render_thread.h"
+#include <SDL2/SDL_thread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "about_section.h"
+#include "../profiling/input_latency.h"
+#include "../profiling/profiler_overlay.h"
+
+//index bit telling the renderer the ready slot holds a snapshot it hasn't drawn yet
+#define SLOT_NEW 4
+
+//a stalled publisher doesn't get its animation run on further than this, in seconds
+#define MAX_EXTRAPOLATION 0.1f
+
+static SDL_Thread *g_renderThread = NULL;
+static SDL_Window *g_window = NULL;
+static SDL_Renderer *g_renderer = NULL;
+static SDL_atomic_t g_stop;
+static SDL_sem *g_published = NULL;
+
+//one slot each for the publisher and the renderer, the third is the newest published one
+static UiSnapshot g_slots[3];
+static Uint64 g_publishTimes[3]; //written with the slot, before it is handed over
+static SDL_atomic_t g_readySlot;
+static int g_writeSlot = 0; //publisher only
+static int g_readSlot = 2;  //renderer only
+
+//screen drawn last, its fonts and textures are released when another one takes over
+static UiScreen g_lastScreen = UI_SCREEN_MENU;
+
+//skipped frames wait as long as a vsynced present would have, 0 doesn't wait
+static SDL_atomic_t g_refreshRate;
+static Uint64 g_lastPresent = 0;
+
+/**
+ * Stands in for the present a skipped frame didn't do. The caller's loop is paced by vsync through the present,
+ * without it an overloaded machine would spin through skipped frames at full speed
+ */
+static void waitForNextRefresh(void) {
+    int rate = SDL_AtomicGet(&g_refreshRate);
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (rate > 0) {
+        Uint64 due = g_lastPresent + SDL_GetPerformanceFrequency() / (Uint64) rate;
+        if (now < due) SDL_Delay((Uint32) ((due - now) * 1000 / SDL_GetPerformanceFrequency()));
+    }
+    g_lastPresent = SDL_GetPerformanceCounter();
+}
+
+void renderUiSetRefreshRate(int hz) {
+    SDL_AtomicSet(&g_refreshRate, hz > 0 ? hz : 0);
+}
+
+void renderUiSnapshot(SDL_Renderer *renderer, const UiSnapshot *snap) {
+    if (g_lastScreen == UI_SCREEN_INGAME && snap->screen != UI_SCREEN_INGAME) ingameUiReleaseRender();
+    g_lastScreen = snap->screen;
+
+    switch (snap->screen) {
+        case UI_SCREEN_MENU:
+            mainMenuRender(renderer, snap->winW, snap->winH, &snap->menu);
+            break;
+        case UI_SCREEN_ABOUT:
+            aboutSectionRender(renderer, snap->winW, snap->winH);
+            break;
+        case UI_SCREEN_INGAME:
+            //a frame the quality governor skipped is neither drawn nor presented, but still takes its time
+            if (!ingameUiRender(renderer, snap->winW, snap->winH, &snap->ingame)) {
+                waitForNextRefresh();
+                return;
+            }
+            break;
+    }
+    if (snap->profiler) profilerOverlayRender(renderer);
+    SDL_RenderPresent(renderer);
+    g_lastPresent = SDL_GetPerformanceCounter();
+    if (snap->screen == UI_SCREEN_INGAME) ingameUiFramePresented();
+
+    inputLatencyFramePresented(snap->screen == UI_SCREEN_INGAME ? snap->ingame.revealKeyTime : 0);
+}
+
+void renderUiRelease(void) {
+    ingameUiReleaseRender();
+    profilerOverlayRelease();
+}
+
+/**
+ * Swaps the renderer's slot with the ready one if something new was published
+ *
+ * @return true if g_readSlot now holds a snapshot that wasn't drawn yet
+ */
+static bool takeSnapshot(void) {
+    if (!(SDL_AtomicGet(&g_readySlot) & SLOT_NEW)) return false;
+    g_readSlot = SDL_AtomicSet(&g_readySlot, g_readSlot) & ~SLOT_NEW;
+    return true;
+}
+
+//a present that doesn't wait for vsync would let the loop spin, hold it to the refresh rate instead
+static void holdToRefreshRate(Uint64 frameStart) {
+    int rate = SDL_AtomicGet(&g_refreshRate);
+    if (rate <= 0) return;
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 interval = frequency / (Uint64) rate;
+    Uint64 spent = SDL_GetPerformanceCounter() - frameStart;
+    if (spent < interval / 2) SDL_Delay((Uint32) ((interval - spent) * 1000 / frequency));
+}
+
+static int renderLoop(void *data) {
+    bool haveSnapshot = false;
+    UiSnapshot frame;
+
+    while (!SDL_AtomicGet(&g_stop)) {
+        //only the first snapshot is waited for, after that every refresh draws the newest one
+        if (!haveSnapshot) SDL_SemWaitTimeout(g_published, 100);
+        else while (SDL_SemTryWait(g_published) == 0) {}
+        if (takeSnapshot()) haveSnapshot = true;
+        if (!haveSnapshot) continue;
+
+        //the snapshot is as old as the last tick, the time since it was published moves the animation on
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        float since = (float) ((double) (frameStart - g_publishTimes[g_readSlot]) / SDL_GetPerformanceFrequency());
+        frame = g_slots[g_readSlot];
+        frame.ingame.sinceUpdate += since < MAX_EXTRAPOLATION ? since : MAX_EXTRAPOLATION;
+
+        renderUiSnapshot(g_renderer, &frame);
+        holdToRefreshRate(frameStart);
+    }
+
+    renderUiRelease();
+    //an OpenGL context can only be current on one thread, let the caller take it back
+    SDL_GL_MakeCurrent(g_window, NULL);
+    return 0;
+}
+
+/**
+ * SDL2 only allows the render API on the thread that created the renderer. The OpenGL backends are the exception
+ * this thread relies on: they keep no thread bound state besides the GL context, which they make current again on
+ * whichever thread draws. Direct3D, Metal and software renderers, and Cocoa windows that must be presented from the
+ * main thread, render inline instead
+ *
+ * @return true if the renderer can be driven from the render thread
+ */
+static bool renderThreadSupported(SDL_Renderer *renderer) {
+#ifdef __APPLE__
+    return false;
+#else
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) != 0) return false;
+    return strncmp(info.name, "opengl", 6) == 0; //opengl and opengles2
+#endif
+}
+
+bool renderThreadStart(SDL_Window *window, SDL_Renderer *renderer) {
+    if (g_renderThread) return true;
+    if (!renderThreadSupported(renderer)) return false;
+    g_window = window;
+    g_renderer = renderer;
+    g_writeSlot = 0;
+    g_readSlot = 2;
+    SDL_AtomicSet(&g_readySlot, 1);
+    SDL_AtomicSet(&g_stop, 0);
+
+    g_published = SDL_CreateSemaphore(0);
+    if (!g_published) {
+        printf("[ERROR] Failed to create render semaphore: %s\n", SDL_GetError());
+        return false;
+    }
+
+    //the loading screen drew from this thread, release the context so the render thread can make it current
+    SDL_GL_MakeCurrent(window, NULL);
+
+    g_renderThread = SDL_CreateThread(renderLoop, "RenderThread", NULL);
+    if (!g_renderThread) {
+        printf("[ERROR] Failed to create render thread: %s\n", SDL_GetError());
+        SDL_DestroySemaphore(g_published);
+        g_published = NULL;
+        return false;
+    }
+    return true;
+}
+
+void renderThreadPublish(const UiSnapshot *snap) {
+    memcpy(&g_slots[g_writeSlot], snap, sizeof(UiSnapshot));
+    g_publishTimes[g_writeSlot] = SDL_GetPerformanceCounter();
+    g_writeSlot = SDL_AtomicSet(&g_readySlot, g_writeSlot | SLOT_NEW) & ~SLOT_NEW;
+    SDL_SemPost(g_published);
+}
+
+void renderThreadStop(void) {
+    if (!g_renderThread) return;
+    SDL_AtomicSet(&g_stop, 1);
+    SDL_SemPost(g_published);
+    SDL_WaitThread(g_renderThread, NULL);
+    g_renderThread = NULL;
+
+    SDL_DestroySemaphore(g_published);
+    g_published = NULL;
+}
@@ -0,0 +1,53 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "main_menu.h"
+#include "ingame_ui.h"
+
+/*
+ * Draws the screens on a thread of its own so a long frame never holds up input. The thread handling events
+ * publishes an immutable UiSnapshot of whatever the current screen draws once per update, and the render thread
+ * draws the newest one on every display refresh, moving its animation on by the time since it was published. The snapshots sit in a lock-free double buffer with a spare slot: the publisher always has a free slot to
+ * write, the renderer keeps the one it is drawing, and a snapshot nobody got to is simply replaced.
+ *
+ * Between renderThreadStart and renderThreadStop the render thread is the only one touching the renderer, and it
+ * never touches the window: the window size comes with every snapshot. SDL2 only promises the render API on the
+ * thread that created the renderer, so the thread is only started for the OpenGL backends, which rebind their
+ * context on the thread that draws. Everything else renders inline
+ */
+
+typedef enum {
+    UI_SCREEN_MENU,
+    UI_SCREEN_ABOUT,
+    UI_SCREEN_INGAME
+} UiScreen;
+
+typedef struct {
+    UiScreen screen;
+    int winW, winH; //read on the event thread, the render thread never asks the window
+    bool profiler;  //profiler overlay on top
+    MenuSnapshot menu;
+    IngameSnapshot ingame;
+} UiSnapshot;
+
+//draws and presents snap on the calling thread, used directly when there is no render thread
+void renderUiSnapshot(SDL_Renderer *renderer, const UiSnapshot *snap);
+
+//refresh rate of the display, frames the ingame screen skips wait that long instead of presenting. 0 never waits
+void renderUiSetRefreshRate(int hz);
+
+//drops the fonts and textures the screens and overlay made while rendering, on the thread that rendered them
+void renderUiRelease(void);
+
+//false if the renderer's backend can't be driven from another thread, the caller then renders inline
+bool renderThreadStart(SDL_Window *window, SDL_Renderer *renderer);
+
+//copies snap into the free slot and makes it the newest, never waits for the renderer
+void renderThreadPublish(const UiSnapshot *snap);
+
+//waits for the frame being drawn and hands the renderer back to the caller, does nothing if it isn't running
+void renderThreadStop(void);
+
+#endif
@@ -0,0 +1,454 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "protocol.h"
+#include "../game/hangman.h"
+#include "../game/word_corpus.h"
+#include "../utility/utilities.h"
+
+#define MAX_THREADS 64
+#define MAX_EVENTS 512
+
+// log-linear latency histogram: 2^SUB_BITS buckets per power of two, about 3% relative error
+#define SUB_BITS 5
+#define SUB_COUNT (1 << SUB_BITS)
+#define HISTOGRAM_BUCKETS (64 * SUB_COUNT)
+
+typedef enum {
+    STRATEGY_RANDOM,
+    STRATEGY_SOLVER
+} GuessStrategy;
+
+typedef struct {
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t total;
+    uint64_t sumNs;
+    uint64_t maxNs;
+} Histogram;
+
+typedef struct {
+    int fd;
+    char in[PROTOCOL_MAX_LINE * 4];
+    int inLen;
+    unsigned long gameId;
+    int category;
+    uint32_t guessedMask;
+    char revealed[MAX_WORD_LEN];
+    uint64_t sentAt; // when the outstanding guess went out, 0 if none
+} BenchClient;
+
+typedef struct {
+    pthread_t thread;
+    BenchClient *clients;
+    int clientCount;
+    int epollFd;
+    uint64_t rng;
+    Histogram latency;
+    unsigned long long guesses, games, errors;
+} BenchThread;
+
+static const char *g_address = "127.0.0.1";
+static int g_port = PROTOCOL_DEFAULT_PORT;
+static GuessStrategy g_strategy = STRATEGY_RANDOM;
+static WordCorpus g_corpus;
+static volatile int g_running = 1;
+
+// fallback order once the solver has no candidate words left
+static const char *englishFrequency = "etaoinsrhldcumfpgwybvkxjqz";
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+static uint32_t nextRandom(BenchThread *thread) {
+    thread->rng ^= thread->rng << 13;
+    thread->rng ^= thread->rng >> 7;
+    thread->rng ^= thread->rng << 17;
+    return (uint32_t) thread->rng;
+}
+
+// HISTOGRAM
+
+static int bucketOf(uint64_t value) {
+    if (value < SUB_COUNT) return (int) value;
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - SUB_BITS;
+    return (shift + 1) * SUB_COUNT + (int) ((value >> shift) & (SUB_COUNT - 1));
+}
+
+static uint64_t bucketLowerBound(int bucket) {
+    if (bucket < SUB_COUNT) return (uint64_t) bucket;
+    int shift = bucket / SUB_COUNT - 1;
+    return ((uint64_t) SUB_COUNT + (uint64_t) (bucket % SUB_COUNT)) << shift;
+}
+
+static void histogramRecord(Histogram *histogram, uint64_t valueNs) {
+    histogram->counts[bucketOf(valueNs)]++;
+    histogram->total++;
+    histogram->sumNs += valueNs;
+    if (valueNs > histogram->maxNs) histogram->maxNs = valueNs;
+}
+
+static void histogramMerge(Histogram *into, const Histogram *from) {
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) into->counts[i] += from->counts[i];
+    into->total += from->total;
+    into->sumNs += from->sumNs;
+    if (from->maxNs > into->maxNs) into->maxNs = from->maxNs;
+}
+
+static double histogramPercentileUs(const Histogram *histogram, double percentile) {
+    if (histogram->total == 0) return 0.0;
+    uint64_t rank = (uint64_t) (percentile / 100.0 * (double) histogram->total);
+    if (rank >= histogram->total) rank = histogram->total - 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen > rank) return bucketLowerBound(i) / 1000.0;
+    }
+    return histogram->maxNs / 1000.0;
+}
+
+// GUESS STRATEGIES
+
+static bool wordMatches(const char *word, const char *revealed, uint32_t guessedMask) {
+    int i = 0;
+    for (; word[i] && revealed[i]; i++) {
+        char r = revealed[i];
+        char w = word[i];
+        if (r == '_' || r == '~') {
+            // a blank can't hide a letter we already tried
+            if (w >= 'a' && w <= 'z' && (guessedMask & (1u << (w - 'a')))) return false;
+        } else if (r != w) {
+            return false;
+        }
+    }
+    if (word[i] || revealed[i]) return false;
+
+    // wrong guesses rule out every word containing them
+    for (i = 0; word[i]; i++) {
+        char w = word[i];
+        if (w >= 'a' && w <= 'z' && (guessedMask & (1u << (w - 'a'))) && !strchr(revealed, w)) return false;
+    }
+    return true;
+}
+
+//most common untried letter among the words of the category that still fit the revealed pattern
+static int solverGuess(const BenchClient *client) {
+    int counts[26] = {0};
+    bool anyCandidate = false;
+
+    if (client->category >= 0) {
+        const WordCategory *category = &g_corpus.categories[client->category];
+        for (int id = category->firstWord; id < category->firstWord + category->wordCount; id++) {
+            const char *word = wordCorpusGetWord(&g_corpus, id);
+            if (!wordMatches(word, client->revealed, client->guessedMask)) continue;
+            anyCandidate = true;
+
+            uint32_t seen = 0;
+            for (const char *p = word; *p; p++) {
+                if (*p < 'a' || *p > 'z') continue;
+                uint32_t bit = 1u << (*p - 'a');
+                if (seen & bit) continue;
+                seen |= bit;
+                counts[*p - 'a']++;
+            }
+        }
+    }
+
+    int best = -1;
+    if (anyCandidate) {
+        for (int i = 0; i < 26; i++) {
+            if (client->guessedMask & (1u << i)) continue;
+            if (best < 0 || counts[i] > counts[best]) best = i;
+        }
+        if (best >= 0 && counts[best] > 0) return best;
+    }
+
+    for (const char *p = englishFrequency; *p; p++) {
+        if (!(client->guessedMask & (1u << (*p - 'a')))) return *p - 'a';
+    }
+    return -1;
+}
+
+static int randomGuess(BenchThread *thread, const BenchClient *client) {
+    if (client->guessedMask == (1u << 26) - 1) return -1;
+    int letter;
+    do {
+        letter = (int) (nextRandom(thread) % 26);
+    } while (client->guessedMask & (1u << letter));
+    return letter;
+}
+
+// CONNECTION DRIVING
+
+static bool sendLine(BenchClient *client, const char *line) {
+    size_t len = strlen(line);
+    return send(client->fd, line, len, MSG_NOSIGNAL) == (ssize_t) len;
+}
+
+static bool sendGuess(BenchThread *thread, BenchClient *client) {
+    char request[64];
+    int letter = g_strategy == STRATEGY_SOLVER ? solverGuess(client) : randomGuess(thread, client);
+    if (letter < 0) {
+        snprintf(request, sizeof(request), "END %lu\n", client->gameId);
+        return sendLine(client, request);
+    }
+
+    client->guessedMask |= 1u << letter;
+    snprintf(request, sizeof(request), "GUESS %lu %c\n", client->gameId, 'a' + letter);
+    client->sentAt = nowNs();
+    return sendLine(client, request);
+}
+
+static bool handleReply(BenchThread *thread, BenchClient *client, char *line) {
+    char request[64];
+
+    if (strncmp(line, "GAME ", 5) == 0) {
+        char category[MAX_CATEGORY_NAME];
+        int revealedAt = 0;
+        if (sscanf(line, "GAME %lu %63s %*d %n", &client->gameId, category, &revealedAt) < 2 || !revealedAt) {
+            return false;
+        }
+        snprintf(client->revealed, sizeof(client->revealed), "%s", line + revealedAt);
+        client->category = wordCorpusFindCategory(&g_corpus, category);
+        client->guessedMask = 0;
+        return sendGuess(thread, client);
+    }
+
+    if (strncmp(line, "OK ", 3) == 0) {
+        if (client->sentAt) {
+            histogramRecord(&thread->latency, nowNs() - client->sentAt);
+            client->sentAt = 0;
+            thread->guesses++;
+        }
+
+        char state[16];
+        int revealedAt = 0;
+        if (sscanf(line, "OK %*u %*d %15s %n", state, &revealedAt) != 1 || !revealedAt) return false;
+        snprintf(client->revealed, sizeof(client->revealed), "%s", line + revealedAt);
+
+        if (strcmp(state, PROTOCOL_STATE_POWER) == 0) {
+            snprintf(request, sizeof(request), "BOX %lu %u\n", client->gameId, nextRandom(thread) % 9 + 1);
+            return sendLine(client, request);
+        }
+        if (strcmp(state, PROTOCOL_STATE_WON) == 0 || strcmp(state, PROTOCOL_STATE_LOST) == 0) {
+            thread->games++;
+            snprintf(request, sizeof(request), "END %lu\n", client->gameId);
+            return sendLine(client, request);
+        }
+        return sendGuess(thread, client);
+    }
+
+    if (strncmp(line, "POWER ", 6) == 0) return true; // the state line follows
+    if (strncmp(line, "BYE ", 4) == 0) return sendLine(client, "NEW\n");
+
+    thread->errors++;
+    client->sentAt = 0;
+    return sendLine(client, "NEW\n");
+}
+
+static int connectClient(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(g_port);
+    inet_pton(AF_INET, g_address, &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+static void *benchThreadMain(void *data) {
+    BenchThread *thread = data;
+    struct epoll_event events[MAX_EVENTS];
+
+    for (int i = 0; i < thread->clientCount; i++) {
+        sendLine(&thread->clients[i], "NEW\n");
+    }
+
+    while (g_running) {
+        int count = epoll_wait(thread->epollFd, events, MAX_EVENTS, 100);
+        for (int i = 0; i < count; i++) {
+            BenchClient *client = events[i].data.ptr;
+            ssize_t n = recv(client->fd, client->in + client->inLen, sizeof(client->in) - client->inLen, 0);
+            bool ok = n > 0 || (n < 0 && (errno == EAGAIN || errno == EINTR));
+
+            if (n > 0) {
+                client->inLen += (int) n;
+                int lineStart = 0;
+                for (int j = 0; j < client->inLen && ok; j++) {
+                    if (client->in[j] != '\n') continue;
+                    client->in[j] = '\0';
+                    ok = handleReply(thread, client, client->in + lineStart);
+                    lineStart = j + 1;
+                }
+                memmove(client->in, client->in + lineStart, client->inLen - lineStart);
+                client->inLen -= lineStart;
+            }
+
+            if (!ok) {
+                thread->errors++;
+                epoll_ctl(thread->epollFd, EPOLL_CTL_DEL, client->fd, NULL);
+                close(client->fd);
+                client->fd = -1;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void writeJson(FILE *out, int connections, int threads, double seconds, const Histogram *latency,
+                      unsigned long long guesses, unsigned long long games, unsigned long long errors) {
+    fprintf(out, "{\n");
+    fprintf(out, "  \"connections\": %d,\n", connections);
+    fprintf(out, "  \"threads\": %d,\n", threads);
+    fprintf(out, "  \"strategy\": \"%s\",\n", g_strategy == STRATEGY_SOLVER ? "solver" : "random");
+    fprintf(out, "  \"duration_s\": %.3f,\n", seconds);
+    fprintf(out, "  \"games\": %llu,\n", games);
+    fprintf(out, "  \"guesses\": %llu,\n", guesses);
+    fprintf(out, "  \"errors\": %llu,\n", errors);
+    fprintf(out, "  \"guesses_per_sec\": %.1f,\n", guesses / seconds);
+    fprintf(out, "  \"latency_us\": {\n");
+    fprintf(out, "    \"mean\": %.2f,\n", latency->total ? latency->sumNs / 1000.0 / latency->total : 0.0);
+    fprintf(out, "    \"p50\": %.2f,\n", histogramPercentileUs(latency, 50.0));
+    fprintf(out, "    \"p99\": %.2f,\n", histogramPercentileUs(latency, 99.0));
+    fprintf(out, "    \"p999\": %.2f,\n", histogramPercentileUs(latency, 99.9));
+    fprintf(out, "    \"max\": %.2f\n", latency->maxNs / 1000.0);
+    fprintf(out, "  }\n");
+    fprintf(out, "}\n");
+}
+
+static void printUsage(const char *program) {
+    printf("usage: %s [-a address] [-p port] [-c connections] [-t threads] [-d seconds] [-s random|solver]"
+           " [-w words directory] [-o results.json]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    int connections = 1000;
+    int threads = 4;
+    double duration = 10.0;
+    const char *wordsDir = "resources/words";
+    const char *outputPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) g_address = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) g_port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) connections = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) duration = atof(argv[++i]);
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) wordsDir = argv[++i];
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputPath = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            if (strcmp(name, "solver") == 0) g_strategy = STRATEGY_SOLVER;
+            else if (strcmp(name, "random") == 0) g_strategy = STRATEGY_RANDOM;
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (connections < threads) connections = threads;
+
+    // the solver needs the same word lists as the server, random guessing works without them
+    static char names[MAX_WORD_FILES][MAX_WORD_FILE_NAME];
+    char *categoryNames[MAX_WORD_FILES];
+    int categoryCount = listWordFiles(wordsDir, names, MAX_WORD_FILES);
+    for (int i = 0; i < categoryCount; i++) categoryNames[i] = names[i];
+    if ((categoryCount <= 0 || !wordCorpusLoad(&g_corpus, wordsDir, categoryNames, categoryCount)) && g_strategy == STRATEGY_SOLVER) {
+        printf("[ERROR] Solver strategy needs the word lists in %s\n", wordsDir);
+        return 1;
+    }
+
+    static BenchThread benchThreads[MAX_THREADS];
+    BenchClient *clients = calloc(connections, sizeof(BenchClient));
+    if (!clients) return 1;
+
+    int assigned = 0;
+    for (int t = 0; t < threads; t++) {
+        BenchThread *thread = &benchThreads[t];
+        thread->clients = clients + assigned;
+        thread->clientCount = connections / threads + (t < connections % threads ? 1 : 0);
+        thread->rng = 0x9E3779B97F4A7C15ULL * (uint64_t) (t + 1);
+        thread->epollFd = epoll_create1(0);
+        assigned += thread->clientCount;
+
+        for (int i = 0; i < thread->clientCount; i++) {
+            BenchClient *client = &thread->clients[i];
+            client->fd = connectClient();
+            if (client->fd < 0) {
+                printf("[ERROR] Connection to %s:%d failed: %s\n", g_address, g_port, strerror(errno));
+                return 1;
+            }
+            struct epoll_event ev = {.events = EPOLLIN, .data.ptr = client};
+            epoll_ctl(thread->epollFd, EPOLL_CTL_ADD, client->fd, &ev);
+        }
+    }
+
+    uint64_t start = nowNs();
+    for (int t = 0; t < threads; t++) {
+        pthread_create(&benchThreads[t].thread, NULL, benchThreadMain, &benchThreads[t]);
+    }
+
+    struct timespec sleepTime = {(time_t) duration, (long) ((duration - (time_t) duration) * 1e9)};
+    nanosleep(&sleepTime, NULL);
+    g_running = 0;
+
+    static Histogram latency;
+    unsigned long long guesses = 0, games = 0, errors = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(benchThreads[t].thread, NULL);
+        histogramMerge(&latency, &benchThreads[t].latency);
+        guesses += benchThreads[t].guesses;
+        games += benchThreads[t].games;
+        errors += benchThreads[t].errors;
+        close(benchThreads[t].epollFd);
+    }
+    double seconds = (nowNs() - start) / 1e9;
+
+    writeJson(stdout, connections, threads, seconds, &latency, guesses, games, errors);
+    if (outputPath) {
+        FILE *out = fopen(outputPath, "w");
+        if (!out) {
+            printf("[ERROR] Failed to write %s\n", outputPath);
+        } else {
+            writeJson(out, connections, threads, seconds, &latency, guesses, games, errors);
+            fclose(out);
+        }
+    }
+
+    for (int i = 0; i < connections; i++) {
+        if (clients[i].fd >= 0) close(clients[i].fd);
+    }
+    free(clients);
+    wordCorpusFree(&g_corpus);
+    return errors ? 2 : 0;
+}
@@ -0,0 +1,200 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "protocol.h"
+
+#define MAX_EVENTS 256
+
+// every connection plays one game at a time: NEW, GUESS until WON/LOST (opening a box on POWER), END, repeat
+typedef struct {
+    int fd;
+    char in[PROTOCOL_MAX_LINE * 4];
+    int inLen;
+    unsigned long gameId;
+    uint32_t guessedMask;
+} Client;
+
+static unsigned long long g_games = 0, g_guesses = 0, g_errors = 0;
+static uint64_t g_rng = 88172645463325252ULL;
+
+static uint32_t nextRandom(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return (uint32_t) g_rng;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool sendLine(Client *client, const char *line) {
+    size_t len = strlen(line);
+    // requests are tiny and one is in flight per connection, so the socket buffer never fills up
+    return send(client->fd, line, len, MSG_NOSIGNAL) == (ssize_t) len;
+}
+
+static bool sendGuess(Client *client) {
+    if (client->guessedMask == (1u << 26) - 1) {
+        char line[64];
+        snprintf(line, sizeof(line), "END %lu\n", client->gameId);
+        return sendLine(client, line);
+    }
+
+    int letter;
+    do {
+        letter = (int) (nextRandom() % 26);
+    } while (client->guessedMask & (1u << letter));
+    client->guessedMask |= 1u << letter;
+
+    char line[64];
+    snprintf(line, sizeof(line), "GUESS %lu %c\n", client->gameId, 'a' + letter);
+    g_guesses++;
+    return sendLine(client, line);
+}
+
+static bool handleReply(Client *client, char *line) {
+    char state[16];
+    char request[64];
+
+    if (strncmp(line, "GAME ", 5) == 0) {
+        client->gameId = strtoul(line + 5, NULL, 10);
+        client->guessedMask = 0;
+        return sendGuess(client);
+    }
+    if (strncmp(line, "OK ", 3) == 0) {
+        if (sscanf(line, "OK %*u %*d %15s", state) != 1) return false;
+        if (strcmp(state, PROTOCOL_STATE_POWER) == 0) {
+            snprintf(request, sizeof(request), "BOX %lu %u\n", client->gameId, nextRandom() % 9 + 1);
+            return sendLine(client, request);
+        }
+        if (strcmp(state, PROTOCOL_STATE_WON) == 0 || strcmp(state, PROTOCOL_STATE_LOST) == 0) {
+            g_games++;
+            snprintf(request, sizeof(request), "END %lu\n", client->gameId);
+            return sendLine(client, request);
+        }
+        return sendGuess(client);
+    }
+    if (strncmp(line, "POWER ", 6) == 0) {
+        return true; // the state line follows
+    }
+    if (strncmp(line, "BYE ", 4) == 0) {
+        return sendLine(client, "NEW\n");
+    }
+
+    // anything unexpected: count it and start over with a fresh game
+    g_errors++;
+    return sendLine(client, "NEW\n");
+}
+
+static int connectClient(const char *address, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, address, &addr.sin_addr);
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+int main(int argc, char *argv[]) {
+    const char *address = "127.0.0.1";
+    int port = PROTOCOL_DEFAULT_PORT;
+    int connections = 100;
+    double duration = 10.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) address = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) connections = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) duration = atof(argv[++i]);
+        else {
+            printf("usage: %s [-a address] [-p port] [-c connections] [-d seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Client *clients = calloc(connections, sizeof(Client));
+    int epollFd = epoll_create1(0);
+    if (!clients || epollFd < 0) {
+        printf("[ERROR] Failed to set up load generator\n");
+        return 1;
+    }
+
+    for (int i = 0; i < connections; i++) {
+        clients[i].fd = connectClient(address, port);
+        if (clients[i].fd < 0) {
+            printf("[ERROR] Connection %d to %s:%d failed: %s\n", i, address, port, strerror(errno));
+            return 1;
+        }
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = &clients[i]};
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, clients[i].fd, &ev);
+        sendLine(&clients[i], "NEW\n");
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+    double start = nowSeconds();
+    int open = connections;
+
+    while (open > 0 && nowSeconds() - start < duration) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+        for (int i = 0; i < count; i++) {
+            Client *client = events[i].data.ptr;
+            ssize_t n = recv(client->fd, client->in + client->inLen, sizeof(client->in) - client->inLen, 0);
+            bool ok = n > 0;
+
+            if (ok) {
+                client->inLen += (int) n;
+                int lineStart = 0;
+                for (int j = 0; j < client->inLen && ok; j++) {
+                    if (client->in[j] != '\n') continue;
+                    client->in[j] = '\0';
+                    ok = handleReply(client, client->in + lineStart);
+                    lineStart = j + 1;
+                }
+                memmove(client->in, client->in + lineStart, client->inLen - lineStart);
+                client->inLen -= lineStart;
+            }
+
+            if (!ok) {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, client->fd, NULL);
+                close(client->fd);
+                client->fd = -1;
+                open--;
+            }
+        }
+    }
+
+    double elapsed = nowSeconds() - start;
+    printf("%d connections, %.1fs: %llu games (%.0f/s), %llu guesses (%.0f/s), %llu errors\n", connections,
+           elapsed, g_games, g_games / elapsed, g_guesses, g_guesses / elapsed, g_errors);
+
+    for (int i = 0; i < connections; i++) {
+        if (clients[i].fd >= 0) close(clients[i].fd);
+    }
+    free(clients);
+    close(epollFd);
+    return g_errors ? 2 : 0;
+}
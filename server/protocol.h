@@ -0,0 +1,32 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+// line based protocol spoken by hangman_server, every message ends with '\n'
+//
+// client -> server
+//   NEW [category [band]] start a game, random category if omitted or *, band is easy, medium or hard
+//   GUESS <id> <letter>   guess a letter in game <id>
+//   BOX <id> <1-9>        open a power up box after a guess hit the super blank
+//   STATE <id>            repeat the current state of game <id>
+//   END <id>              drop game <id>
+//   QUIT                  close the connection
+//
+// server -> client
+//   GAME <id> <category> <lives> <revealed>
+//   OK <id> <lives> <PLAYING|POWER|WON|LOST> <revealed>
+//   POWER <id> <message>
+//   BYE <id>
+//   ERR <reason>
+//
+// the revealed word is always the last field since it may contain spaces
+
+#define PROTOCOL_DEFAULT_PORT 7777
+#define PROTOCOL_MAX_LINE 256
+#define PROTOCOL_MAX_GAMES_PER_CONNECTION 64
+
+#define PROTOCOL_STATE_PLAYING "PLAYING"
+#define PROTOCOL_STATE_POWER "POWER"
+#define PROTOCOL_STATE_WON "WON"
+#define PROTOCOL_STATE_LOST "LOST"
+
+#endif
@@ -0,0 +1,541 @@
+#define _GNU_SOURCE // accept4
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "protocol.h"
+#include "session_pool.h"
+#include "../game/hangman.h"
+#include "../game/word_corpus.h"
+#include "../game/word_scheduler.h"
+#include "../utility/utilities.h"
+
+#define MAX_SHARDS 64
+#define MAX_EVENTS 256
+#define STARTING_LIVES 6
+
+typedef struct {
+    int fd;
+    char in[PROTOCOL_MAX_LINE * 4];
+    int inLen;
+    char *out;
+    int outLen, outCap;
+    bool wantWrite;
+    bool closing;
+    int sessionHead; // first session owned by this connection, linked through Session.next
+    int sessionCount;
+    WordScheduler words; // a client sees every word of a category before any repeats
+} Connection;
+
+// every worker thread owns one shard: its own listener, epoll set and session table, so nothing is shared
+typedef struct {
+    int index;
+    int listenFd;
+    int epollFd;
+    SessionPool pool;
+    uint64_t rng;
+    pthread_t thread;
+    unsigned long long games;
+    unsigned long long guesses;
+    int connections;
+} Shard;
+
+static WordCorpus g_corpus;
+static Shard g_shards[MAX_SHARDS];
+static int g_shardCount = 0;
+static volatile sig_atomic_t g_running = 1;
+
+static uint64_t nextRandom(Shard *shard) {
+    // xorshift64*, one state per shard so picking words never contends
+    shard->rng ^= shard->rng >> 12;
+    shard->rng ^= shard->rng << 25;
+    shard->rng ^= shard->rng >> 27;
+    return shard->rng * 0x2545F4914F6CDD1DULL;
+}
+
+// nextRandom as a HangmanRng, so super blanks and power ups draw from the shard instead of the global rand()
+static int shardRandom(void *state) {
+    return (int) (nextRandom(state) >> 33);
+}
+
+static int setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static int openListener(const char *address, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    // every shard binds the same port, the kernel spreads incoming connections between them
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+        perror("[ERROR] SO_REUSEPORT");
+        close(fd);
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address, &addr.sin_addr) != 1 ||
+        bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+        listen(fd, 4096) < 0 || setNonBlocking(fd) < 0) {
+        perror("[ERROR] Failed to open listener");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// OUTPUT
+
+static void appendOutput(Connection *conn, const char *data, int len) {
+    if (conn->outLen + len > conn->outCap) {
+        int newCap = conn->outCap ? conn->outCap * 2 : 1024;
+        while (newCap < conn->outLen + len) newCap *= 2;
+        char *out = realloc(conn->out, newCap);
+        if (!out) {
+            conn->closing = true;
+            return;
+        }
+        conn->out = out;
+        conn->outCap = newCap;
+    }
+    memcpy(conn->out + conn->outLen, data, len);
+    conn->outLen += len;
+}
+
+static void reply(Connection *conn, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+static void reply(Connection *conn, const char *format, ...) {
+    char line[PROTOCOL_MAX_LINE * 2];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(line, sizeof(line) - 1, format, args);
+    va_end(args);
+    if (len < 0) return;
+    if (len > (int) sizeof(line) - 2) len = sizeof(line) - 2;
+    line[len++] = '\n';
+    appendOutput(conn, line, len);
+}
+
+//tries to write everything queued, returns false if the connection broke
+static bool flushOutput(Shard *shard, Connection *conn) {
+    int sent = 0;
+    while (sent < conn->outLen) {
+        ssize_t n = send(conn->fd, conn->out + sent, conn->outLen - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        sent += (int) n;
+    }
+    memmove(conn->out, conn->out + sent, conn->outLen - sent);
+    conn->outLen -= sent;
+
+    // only ask for writability while something is still queued
+    bool wantWrite = conn->outLen > 0;
+    if (wantWrite != conn->wantWrite) {
+        struct epoll_event ev = {.events = EPOLLIN | (wantWrite ? EPOLLOUT : 0), .data.ptr = conn};
+        epoll_ctl(shard->epollFd, EPOLL_CTL_MOD, conn->fd, &ev);
+        conn->wantWrite = wantWrite;
+    }
+    return true;
+}
+
+// GAME COMMANDS
+
+static const char *gameStateName(const Session *session) {
+    if (isGameWon(&session->game)) return PROTOCOL_STATE_WON;
+    if (isGameOver(&session->game)) return PROTOCOL_STATE_LOST;
+    if (session->powerPending) return PROTOCOL_STATE_POWER;
+    return PROTOCOL_STATE_PLAYING;
+}
+
+static void replyState(Shard *shard, Connection *conn, int index) {
+    Session *session = sessionPoolGet(&shard->pool, index);
+    reply(conn, "OK %u %d %s %s", sessionPoolMakeId(&shard->pool, index), getRemainingLives(&session->game),
+          gameStateName(session), getRevealedWord(&session->game));
+}
+
+//resolves an id that must belong to this connection
+static Session *ownedSession(Shard *shard, Connection *conn, const char *idText, int *outIndex) {
+    char *end;
+    unsigned long id = strtoul(idText, &end, 10);
+    if (end == idText) return NULL;
+
+    Session *session = sessionPoolLookup(&shard->pool, (uint32_t) id, outIndex);
+    if (!session || session->owner != conn->fd) return NULL;
+    return session;
+}
+
+static void hidePowerUps(Shard *shard, Session *session) {
+    // same rules as powerUpMenu(): 3 of the 9 boxes hold a random power up
+    for (int i = 0; i < 9; i++) session->boxPower[i] = 0;
+    int placed = 0;
+    while (placed < 3) {
+        int box = (int) (nextRandom(shard) % 9);
+        if (session->boxPower[box]) continue;
+        session->boxPower[box] = (int) (nextRandom(shard) % 5) + 1;
+        placed++;
+    }
+    session->powerPending = true;
+}
+
+static void commandNew(Shard *shard, Connection *conn, const char *categoryName, const char *bandName) {
+    if (conn->sessionCount >= PROTOCOL_MAX_GAMES_PER_CONNECTION) {
+        reply(conn, "ERR too many games");
+        return;
+    }
+
+    DifficultyBand band = DIFFICULTY_BANDS;
+    if (bandName && (band = wordDifficultyFindBand(bandName)) == DIFFICULTY_BANDS) {
+        reply(conn, "ERR unknown difficulty");
+        return;
+    }
+
+    int category;
+    if (categoryName && *categoryName && strcmp(categoryName, "*") != 0) {
+        category = wordCorpusFindCategory(&g_corpus, categoryName);
+        if (category < 0) {
+            reply(conn, "ERR unknown category");
+            return;
+        }
+    } else {
+        category = (int) (nextRandom(shard) % g_corpus.categoryCount);
+    }
+
+    const WordCategory *cat = &g_corpus.categories[category];
+    int wordId = band == DIFFICULTY_BANDS
+                 ? wordSchedulerNext(&conn->words, &g_corpus, category)
+                 : wordCorpusPickByDifficulty(&g_corpus, category, band, nextRandom(shard));
+
+    int index = sessionPoolAlloc(&shard->pool);
+    if (index < 0) {
+        reply(conn, "ERR server full");
+        return;
+    }
+
+    Session *session = sessionPoolGet(&shard->pool, index);
+    initHangmanInPlaceWith(&session->game, cat->name, wordCorpusGetWord(&g_corpus, wordId), STARTING_LIVES,
+                           shardRandom, shard);
+    session->game.wordId = wordId;
+    session->owner = conn->fd;
+    session->next = conn->sessionHead;
+    conn->sessionHead = index;
+    conn->sessionCount++;
+    shard->games++;
+
+    reply(conn, "GAME %u %s %d %s", sessionPoolMakeId(&shard->pool, index), cat->name,
+          getRemainingLives(&session->game), getRevealedWord(&session->game));
+}
+
+static void commandGuess(Shard *shard, Connection *conn, const char *idText, const char *letter) {
+    int index;
+    Session *session = ownedSession(shard, conn, idText, &index);
+    if (!session) {
+        reply(conn, "ERR unknown game");
+        return;
+    }
+    if (isGameOver(&session->game)) {
+        reply(conn, "ERR game over");
+        return;
+    }
+    if (!letter || letter[0] == '\0' || letter[1] != '\0' || !validateGuess(&session->game, letter[0])) {
+        reply(conn, "ERR invalid guess");
+        return;
+    }
+
+    char guess = (char) tolower((unsigned char) letter[0]);
+    if (processGuess(&session->game, guess)) hidePowerUps(shard, session);
+    appendCharToArray(session->game.guessed, guess, &session->game.numGuessed, MAX_GUESSED);
+    shard->guesses++;
+
+    replyState(shard, conn, index);
+}
+
+static void commandBox(Shard *shard, Connection *conn, const char *idText, const char *boxText) {
+    int index;
+    Session *session = ownedSession(shard, conn, idText, &index);
+    if (!session) {
+        reply(conn, "ERR unknown game");
+        return;
+    }
+    int box = boxText ? atoi(boxText) : 0;
+    if (!session->powerPending || box < 1 || box > 9) {
+        reply(conn, "ERR no box to open");
+        return;
+    }
+
+    session->powerPending = false;
+    int power = session->boxPower[box - 1];
+    char message[256];
+    applyPowerUp(&session->game, power, shardRandom, shard, message, sizeof(message));
+
+    // the protocol is one line per reply
+    size_t length = strlen(message);
+    if (length > 0 && message[length - 1] == '\n') message[--length] = '\0';
+    for (size_t i = 0; i < length; i++) {
+        if (message[i] == '\n') message[i] = ' ';
+    }
+    if (length == 0) snprintf(message, sizeof(message), "%s", power ? "Nothing happened." : "Empty box, no power up.");
+    reply(conn, "POWER %u %s", sessionPoolMakeId(&shard->pool, index), message);
+    replyState(shard, conn, index);
+}
+
+static void commandEnd(Shard *shard, Connection *conn, const char *idText) {
+    int index;
+    if (!ownedSession(shard, conn, idText, &index)) {
+        reply(conn, "ERR unknown game");
+        return;
+    }
+
+    // unlink from the connection's list, at most PROTOCOL_MAX_GAMES_PER_CONNECTION long
+    int *link = &conn->sessionHead;
+    while (*link != index) link = &sessionPoolGet(&shard->pool, *link)->next;
+    *link = sessionPoolGet(&shard->pool, index)->next;
+    conn->sessionCount--;
+
+    reply(conn, "BYE %u", sessionPoolMakeId(&shard->pool, index));
+    sessionPoolFree(&shard->pool, index);
+}
+
+static void handleLine(Shard *shard, Connection *conn, char *line) {
+    char *save = NULL;
+    char *command = strtok_r(line, " \t\r", &save);
+    char *arg1 = strtok_r(NULL, " \t\r", &save);
+    char *arg2 = strtok_r(NULL, " \t\r", &save);
+    if (!command) return;
+
+    if (strcmp(command, "GUESS") == 0) {
+        if (arg1) commandGuess(shard, conn, arg1, arg2);
+        else reply(conn, "ERR missing game id");
+    } else if (strcmp(command, "NEW") == 0) {
+        commandNew(shard, conn, arg1, arg2);
+    } else if (strcmp(command, "BOX") == 0) {
+        if (arg1) commandBox(shard, conn, arg1, arg2);
+        else reply(conn, "ERR missing game id");
+    } else if (strcmp(command, "STATE") == 0) {
+        int index;
+        if (arg1 && ownedSession(shard, conn, arg1, &index)) replyState(shard, conn, index);
+        else reply(conn, "ERR unknown game");
+    } else if (strcmp(command, "END") == 0) {
+        if (arg1) commandEnd(shard, conn, arg1);
+        else reply(conn, "ERR missing game id");
+    } else if (strcmp(command, "QUIT") == 0) {
+        conn->closing = true;
+    } else {
+        reply(conn, "ERR unknown command");
+    }
+}
+
+// CONNECTIONS
+
+static void closeConnection(Shard *shard, Connection *conn) {
+    // games die with the connection that created them
+    int index = conn->sessionHead;
+    while (index >= 0) {
+        int next = sessionPoolGet(&shard->pool, index)->next;
+        sessionPoolFree(&shard->pool, index);
+        index = next;
+    }
+
+    epoll_ctl(shard->epollFd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    free(conn->out);
+    free(conn);
+    shard->connections--;
+}
+
+static void acceptConnections(Shard *shard) {
+    for (;;) {
+        int fd = accept4(shard->listenFd, NULL, NULL, SOCK_NONBLOCK);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return; // EAGAIN or a transient error, epoll will wake us again
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        Connection *conn = calloc(1, sizeof(Connection));
+        if (!conn) {
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->sessionHead = -1;
+        wordSchedulerInit(&conn->words, nextRandom(shard));
+
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = conn};
+        if (epoll_ctl(shard->epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            free(conn);
+            continue;
+        }
+        shard->connections++;
+    }
+}
+
+//reads what is available and runs every complete line, returns false if the connection should close
+static bool readConnection(Shard *shard, Connection *conn) {
+    for (;;) {
+        ssize_t n = recv(conn->fd, conn->in + conn->inLen, sizeof(conn->in) - conn->inLen, 0);
+        if (n == 0) return false;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        conn->inLen += (int) n;
+
+        int start = 0;
+        for (int i = 0; i < conn->inLen; i++) {
+            if (conn->in[i] != '\n') continue;
+            conn->in[i] = '\0';
+            handleLine(shard, conn, conn->in + start);
+            start = i + 1;
+        }
+        memmove(conn->in, conn->in + start, conn->inLen - start);
+        conn->inLen -= start;
+
+        // a line that doesn't fit the buffer is a protocol violation
+        if (conn->inLen == (int) sizeof(conn->in)) return false;
+    }
+
+    return flushOutput(shard, conn) && !(conn->closing && conn->outLen == 0);
+}
+
+static void *shardMain(void *data) {
+    Shard *shard = data;
+    struct epoll_event events[MAX_EVENTS];
+
+    while (g_running) {
+        int count = epoll_wait(shard->epollFd, events, MAX_EVENTS, 200);
+        for (int i = 0; i < count; i++) {
+            Connection *conn = events[i].data.ptr;
+            if (!conn) {
+                acceptConnections(shard);
+                continue;
+            }
+
+            bool keep = true;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) keep = false;
+            if (keep && (events[i].events & EPOLLIN)) keep = readConnection(shard, conn);
+            if (keep && (events[i].events & EPOLLOUT)) {
+                keep = flushOutput(shard, conn) && !(conn->closing && conn->outLen == 0);
+            }
+            if (!keep) closeConnection(shard, conn);
+        }
+    }
+    return NULL;
+}
+
+static bool startShard(Shard *shard, int index, const char *address, int port) {
+    shard->index = index;
+    shard->rng = 0x9E3779B97F4A7C15ULL * (uint64_t) (index + 1) ^ (uint64_t) time(NULL);
+    sessionPoolInit(&shard->pool);
+
+    shard->listenFd = openListener(address, port);
+    if (shard->listenFd < 0) return false;
+
+    shard->epollFd = epoll_create1(0);
+    struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+    if (shard->epollFd < 0 || epoll_ctl(shard->epollFd, EPOLL_CTL_ADD, shard->listenFd, &ev) < 0) {
+        perror("[ERROR] epoll setup failed");
+        return false;
+    }
+
+    return pthread_create(&shard->thread, NULL, shardMain, shard) == 0;
+}
+
+static void printUsage(const char *program) {
+    printf("usage: %s [-a address] [-p port] [-t threads] [-w words directory]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+    const char *address = "127.0.0.1";
+    const char *wordsDir = "resources/words";
+    int port = PROTOCOL_DEFAULT_PORT;
+    int threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) address = argv[++i];
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) wordsDir = argv[++i];
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_SHARDS) threads = MAX_SHARDS;
+
+    // every .txt file in the words directory is a category
+    static char names[MAX_WORD_FILES][MAX_WORD_FILE_NAME];
+    char *categoryNames[MAX_WORD_FILES];
+    int categoryCount = listWordFiles(wordsDir, names, MAX_WORD_FILES);
+    for (int i = 0; i < categoryCount; i++) categoryNames[i] = names[i];
+    if (categoryCount <= 0 || !wordCorpusLoad(&g_corpus, wordsDir, categoryNames, categoryCount)) {
+        printf("[ERROR] Failed to load words from %s\n", wordsDir);
+        return 1;
+    }
+
+    // workers inherit this mask, only the main thread waits for shutdown signals
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    for (int i = 0; i < threads; i++) {
+        if (!startShard(&g_shards[i], i, address, port)) {
+            printf("[ERROR] Failed to start shard %d\n", i);
+            g_running = 0;
+            break;
+        }
+        g_shardCount++;
+    }
+
+    if (g_running) {
+        printf("hangman_server listening on %s:%d with %d shards, %d words\n", address, port, g_shardCount,
+               g_corpus.wordCount);
+        fflush(stdout);
+        int sig;
+        sigwait(&signals, &sig);
+        g_running = 0;
+    }
+
+    unsigned long long games = 0, guesses = 0;
+    for (int i = 0; i < g_shardCount; i++) {
+        pthread_join(g_shards[i].thread, NULL);
+        games += g_shards[i].games;
+        guesses += g_shards[i].guesses;
+        close(g_shards[i].epollFd);
+        close(g_shards[i].listenFd);
+        sessionPoolDestroy(&g_shards[i].pool);
+    }
+    printf("served %llu games, %llu guesses\n", games, guesses);
+
+    wordCorpusFree(&g_corpus);
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "session_pool.h"
+
+/**
+ * Prepares an empty pool, memory is only allocated once the first session is needed
+ *
+ * @param pool pool to initialise
+ */
+void sessionPoolInit(SessionPool *pool) {
+    memset(pool, 0, sizeof(SessionPool));
+    pool->freeHead = -1;
+}
+
+/**
+ * Frees every slab of the pool
+ *
+ * @param pool pool to destroy
+ */
+void sessionPoolDestroy(SessionPool *pool) {
+    for (int i = 0; i < pool->slabCount; i++) {
+        free(pool->slabs[i]);
+    }
+    free(pool->slabs);
+    sessionPoolInit(pool);
+}
+
+/**
+ * Adds one slab of sessions and threads them onto the free list
+ *
+ * @return false if the pool reached SESSION_MAX or memory ran out
+ */
+static bool growPool(SessionPool *pool) {
+    if (pool->capacity + SESSION_SLAB_SIZE > SESSION_MAX) return false;
+
+    Session **slabs = realloc(pool->slabs, (pool->slabCount + 1) * sizeof(Session *));
+    if (!slabs) return false;
+    pool->slabs = slabs;
+
+    Session *slab = calloc(SESSION_SLAB_SIZE, sizeof(Session));
+    if (!slab) return false;
+    pool->slabs[pool->slabCount++] = slab;
+
+    // push in reverse so slots are handed out in ascending order
+    for (int i = SESSION_SLAB_SIZE - 1; i >= 0; i--) {
+        slab[i].next = pool->freeHead;
+        pool->freeHead = pool->capacity + i;
+    }
+    pool->capacity += SESSION_SLAB_SIZE;
+    return true;
+}
+
+/**
+ * Takes a session slot from the free list
+ *
+ * @param pool pool to allocate from
+ * @return slot index, -1 if no more sessions can be created
+ */
+int sessionPoolAlloc(SessionPool *pool) {
+    if (pool->freeHead < 0 && !growPool(pool)) return -1;
+
+    int index = pool->freeHead;
+    Session *session = sessionPoolGet(pool, index);
+    pool->freeHead = session->next;
+
+    session->inUse = true;
+    session->powerPending = false;
+    session->next = -1;
+    pool->liveCount++;
+    return index;
+}
+
+/**
+ * Returns a slot to the free list, ids pointing at it stop resolving
+ *
+ * @param pool pool the slot came from
+ * @param index slot index
+ */
+void sessionPoolFree(SessionPool *pool, int index) {
+    Session *session = sessionPoolGet(pool, index);
+    if (!session || !session->inUse) return;
+
+    session->inUse = false;
+    session->generation++;
+    session->next = pool->freeHead;
+    pool->freeHead = index;
+    pool->liveCount--;
+}
+
+/**
+ * Resolves a slot index to its session
+ *
+ * @param pool pool the slot belongs to
+ * @param index slot index
+ * @return the session, NULL if the index is out of range
+ */
+Session *sessionPoolGet(const SessionPool *pool, int index) {
+    if (index < 0 || index >= pool->capacity) return NULL;
+    return &pool->slabs[index >> SESSION_SLAB_SHIFT][index & (SESSION_SLAB_SIZE - 1)];
+}
+
+/**
+ * Builds the id clients use to refer to a session
+ *
+ * @param pool pool the slot belongs to
+ * @param index slot index
+ * @return slot index in the low bits, generation in the high bits
+ */
+uint32_t sessionPoolMakeId(const SessionPool *pool, int index) {
+    Session *session = sessionPoolGet(pool, index);
+    return ((uint32_t) (session->generation & 0xFFF) << SESSION_INDEX_BITS) | (uint32_t) index;
+}
+
+/**
+ * Resolves a client id back to a live session
+ *
+ * @param pool pool to look in
+ * @param id id built by sessionPoolMakeId
+ * @param outIndex set to the slot index when found, may be NULL
+ * @return the session, NULL if the id is stale or invalid
+ */
+Session *sessionPoolLookup(const SessionPool *pool, uint32_t id, int *outIndex) {
+    int index = (int) (id & (SESSION_MAX - 1));
+    Session *session = sessionPoolGet(pool, index);
+    if (!session || !session->inUse) return NULL;
+    if ((session->generation & 0xFFF) != (id >> SESSION_INDEX_BITS)) return NULL;
+
+    if (outIndex) *outIndex = index;
+    return session;
+}
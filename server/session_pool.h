@@ -0,0 +1,50 @@
+#ifndef SESSION_POOL_H
+#define SESSION_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../game/hangman.h"
+
+#define SESSION_SLAB_SHIFT 10
+#define SESSION_SLAB_SIZE (1 << SESSION_SLAB_SHIFT)
+#define SESSION_INDEX_BITS 20
+#define SESSION_MAX (1 << SESSION_INDEX_BITS)
+
+typedef struct {
+    GameState game;
+    int boxPower[9];      // power id hidden in each box, 0 if empty
+    bool powerPending;    // a guess hit the super blank and no box was opened yet
+    bool inUse;
+    uint16_t generation;  // bumped on free so stale ids are rejected
+    int owner;            // connection the session belongs to
+    int next;             // next free slot, or next session of the same owner
+} Session;
+
+// slab allocator for sessions, slabs are never moved so Session pointers stay valid
+typedef struct {
+    Session **slabs;
+    int slabCount;
+    int capacity;
+    int freeHead;
+    int liveCount;
+} SessionPool;
+
+void sessionPoolInit(SessionPool *pool);
+
+void sessionPoolDestroy(SessionPool *pool);
+
+// returns the slot index of a fresh session, -1 if the pool is exhausted
+int sessionPoolAlloc(SessionPool *pool);
+
+void sessionPoolFree(SessionPool *pool, int index);
+
+Session *sessionPoolGet(const SessionPool *pool, int index);
+
+// ids handed to clients pack the slot index with its generation
+uint32_t sessionPoolMakeId(const SessionPool *pool, int index);
+
+// returns the live session for an id, NULL if it was freed or never existed
+Session *sessionPoolLookup(const SessionPool *pool, uint32_t id, int *outIndex);
+
+#endif
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game/word_scheduler.h"
+#include "utility/utilities.h"
+
+// draws words for many players, category by category and at random, and checks that every category hands out
+// each of its words once per cycle and never starts a cycle with the word the last one ended on
+
+#define PLAYERS 500
+#define CYCLES 4
+
+// what one category of one player handed out in its current cycle
+typedef struct {
+    bool *seen;
+    int picked;
+    int lastWord;
+} CycleCheck;
+
+int main(int argc, char *argv[]) {
+    const char *wordsDir = argc > 1 ? argv[1] : "resources/words";
+    srand(argc > 2 ? (unsigned int) atoi(argv[2]) : 1);
+
+    static char names[MAX_WORD_FILES][MAX_WORD_FILE_NAME];
+    char *categoryNames[MAX_WORD_FILES];
+    int categoryCount = listWordFiles(wordsDir, names, MAX_WORD_FILES);
+    for (int i = 0; i < categoryCount; i++) categoryNames[i] = names[i];
+
+    WordCorpus corpus;
+    if (categoryCount <= 0 || !wordCorpusLoad(&corpus, wordsDir, categoryNames, categoryCount)) {
+        printf("[ERROR] No word lists in %s\n", wordsDir);
+        return 1;
+    }
+
+    CycleCheck checks[MAX_CATEGORIES];
+    for (int c = 0; c < corpus.categoryCount; c++) checks[c].seen = calloc(corpus.categories[c].wordCount, 1);
+
+    int failures = 0;
+    long long picks = 0;
+    for (int p = 0; p < PLAYERS && failures < 10; p++) {
+        WordScheduler scheduler;
+        wordSchedulerInit(&scheduler, (uint64_t) p * 0x9E3779B97F4A7C15ull + 1);
+        for (int c = 0; c < corpus.categoryCount; c++) {
+            memset(checks[c].seen, 0, corpus.categories[c].wordCount);
+            checks[c].picked = 0;
+            checks[c].lastWord = -1;
+        }
+
+        //half the players pick their categories, the other half leave it to the scheduler
+        int draws = CYCLES * corpus.wordCount;
+        for (int d = 0; d < draws && failures < 10; d++) {
+            int wanted = p % 2 ? rand() % corpus.categoryCount : -1;
+            int wordId = wordSchedulerNext(&scheduler, &corpus, wanted);
+            int c = wordCorpusGetCategoryOfWord(&corpus, wordId);
+            if (c < 0 || (wanted >= 0 && c != wanted)) {
+                printf("[ERROR] Player %d got word %d outside category %d\n", p, wordId, wanted);
+                failures++;
+                continue;
+            }
+            picks++;
+
+            const WordCategory *category = &corpus.categories[c];
+            CycleCheck *check = &checks[c];
+            int offset = wordId - category->firstWord;
+            if (check->picked == category->wordCount) {
+                //a new cycle, it must not open with the word the last one ended on
+                if (category->wordCount > 1 && wordId == check->lastWord) {
+                    printf("[ERROR] Player %d got %s twice across a cycle of %s\n", p,
+                           wordCorpusGetWord(&corpus, wordId), category->name);
+                    failures++;
+                }
+                memset(check->seen, 0, category->wordCount);
+                check->picked = 0;
+            }
+            if (check->seen[offset]) {
+                printf("[ERROR] Player %d got %s twice in one cycle of %s\n", p,
+                       wordCorpusGetWord(&corpus, wordId), category->name);
+                failures++;
+            }
+            check->seen[offset] = true;
+            check->picked++;
+            check->lastWord = wordId;
+        }
+    }
+
+    for (int c = 0; c < corpus.categoryCount; c++) free(checks[c].seen);
+    wordCorpusFree(&corpus);
+    printf("%lld words scheduled for %d players, %d failures\n", picks, PLAYERS, failures);
+    return failures ? 1 : 0;
+}
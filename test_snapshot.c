@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game/game_snapshot.h"
+#include "utility/utilities.h"
+
+// plays random games part way, guesses and power ups included, and checks every one comes back the same from
+// a snapshot record and from a session file
+
+#define GAMES 2000
+#define FILE_GAMES 64
+#define SESSION_FILE "test_snapshot.bin"
+
+//decoded guesses come back in alphabetical order, so only the set of guessed letters is compared
+static unsigned int guessedLetters(const GameState *game) {
+    unsigned int mask = 0;
+    for (int i = 0; i < game->numGuessed; i++) mask |= 1u << (game->guessed[i] - 'a');
+    return mask;
+}
+
+static bool sameGame(const GameState *a, const GameState *b) {
+    return strcmp(a->wordFile, b->wordFile) == 0 && strcmp(a->word, b->word) == 0 &&
+           strcmp(a->revealed, b->revealed) == 0 && a->numGuessed == b->numGuessed &&
+           guessedLetters(a) == guessedLetters(b) && a->lives == b->lives &&
+           a->shieldActive == b->shieldActive && a->superBlankPos == b->superBlankPos && a->wordId == b->wordId;
+}
+
+static void playRandomly(GameState *game) {
+    int moves = rand() % 30;
+    for (int m = 0; m < moves && !isGameOver(game); m++) {
+        if (rand() % 8 == 0) {
+            char message[256];
+            applyPowerUp(game, rand() % 6 + 1, hangmanRand, NULL, message, sizeof(message));
+            continue;
+        }
+        char guess = (char) ('a' + rand() % 26);
+        if (!validateGuess(game, guess)) continue;
+        processGuess(game, guess);
+        appendCharToArray(game->guessed, guess, &game->numGuessed, MAX_GUESSED);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *wordsDir = argc > 1 ? argv[1] : "resources/words";
+    srand(argc > 2 ? (unsigned int) atoi(argv[2]) : 1);
+
+    static char names[MAX_WORD_FILES][MAX_WORD_FILE_NAME];
+    char *categoryNames[MAX_WORD_FILES];
+    int categoryCount = listWordFiles(wordsDir, names, MAX_WORD_FILES);
+    for (int i = 0; i < categoryCount; i++) categoryNames[i] = names[i];
+
+    WordCorpus corpus;
+    if (categoryCount <= 0 || !wordCorpusLoad(&corpus, wordsDir, categoryNames, categoryCount)) {
+        printf("[ERROR] No word lists in %s\n", wordsDir);
+        return 1;
+    }
+
+    static GameState played[GAMES];
+    int failures = 0;
+    for (int g = 0; g < GAMES; g++) {
+        GameState *game = &played[g];
+        wordCorpusStartRandomGame(&corpus, game, rand() % 7);
+        playRandomly(game);
+
+        uint8_t record[GAME_SNAPSHOT_MAX_BYTES];
+        size_t length = gameSnapshotEncode(game, &corpus, record, sizeof(record));
+        GameState decoded;
+        if (!length || gameSnapshotDecode(&decoded, &corpus, record, length) != length || !sameGame(game, &decoded)) {
+            printf("[ERROR] Game %d (%s, revealed %s, lives %d) changed in its snapshot\n", g, game->word,
+                   game->revealed, game->lives);
+            failures++;
+        }
+    }
+
+    //a game without its id has to be found by name, one with a stale id must not be trusted
+    GameState renamed = played[0];
+    renamed.wordId = (renamed.wordId + 1) % corpus.wordCount;
+    uint8_t stale[GAME_SNAPSHOT_MAX_BYTES], fresh[GAME_SNAPSHOT_MAX_BYTES];
+    size_t staleLength = gameSnapshotEncode(&renamed, &corpus, stale, sizeof(stale));
+    size_t freshLength = gameSnapshotEncode(&played[0], &corpus, fresh, sizeof(fresh));
+    if (staleLength != freshLength || memcmp(stale, fresh, freshLength) != 0) {
+        printf("[ERROR] A stale word id changed the snapshot of %s\n", played[0].word);
+        failures++;
+    }
+
+    GameState loaded[FILE_GAMES];
+    if (!gameSnapshotSaveFile(SESSION_FILE, &corpus, played, FILE_GAMES) ||
+        gameSnapshotLoadFile(SESSION_FILE, &corpus, loaded, FILE_GAMES) != FILE_GAMES) {
+        printf("[ERROR] Session file round trip failed\n");
+        failures++;
+    } else {
+        for (int g = 0; g < FILE_GAMES; g++) {
+            if (!sameGame(&played[g], &loaded[g])) {
+                printf("[ERROR] Game %d changed in the session file\n", g);
+                failures++;
+            }
+        }
+    }
+    remove(SESSION_FILE);
+
+    wordCorpusFree(&corpus);
+    printf("%d games round tripped, %d failures\n", GAMES, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,183 @@
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "game/hangman.h"
+
+// runs hangman_wordprep on a raw list full of case, blank and duplicate variations and checks the cleaned list
+// against a plain reference, and that the thread count changes neither the list nor the difficulty file
+
+#define LINES 6000
+#define THREAD_COUNTS 3
+#define RAW_LINE_MAX (MAX_WORD_LEN * 2)
+
+static const int threadCounts[THREAD_COUNTS] = {1, 4, 7};
+
+// few syllables, so the same word comes back often and in far apart chunks
+static const char *syllables[] = {"ka", "to", "ri", "ne", "su", "mo", "la", "pe"};
+
+static char expected[LINES][MAX_WORD_LEN];
+static int expectedCount = 0;
+
+//the reference: trim, one space between words, lower case, only letters, first of every duplicate kept
+static void expect(const char *line) {
+    char word[RAW_LINE_MAX];
+    int n = 0;
+    bool pendingSpace = false;
+    for (const char *p = line; *p; p++) {
+        if (isspace((unsigned char) *p)) {
+            pendingSpace = n > 0;
+            continue;
+        }
+        if (!isalpha((unsigned char) *p)) return;
+        if (pendingSpace) word[n++] = ' ';
+        pendingSpace = false;
+        word[n++] = (char) tolower((unsigned char) *p);
+    }
+    word[n] = '\0';
+    if (n == 0 || n >= MAX_WORD_LEN) return;
+
+    for (int i = 0; i < expectedCount; i++) {
+        if (strcmp(expected[i], word) == 0) return;
+    }
+    strcpy(expected[expectedCount++], word);
+}
+
+static void makeLine(char *line) {
+    int n = 0;
+    if (rand() % 4 == 0) line[n++] = rand() % 2 ? ' ' : '\t';
+    int parts = rand() % 3 + 1;
+    for (int p = 0; p < parts; p++) {
+        if (p > 0) {
+            line[n++] = ' ';
+            if (rand() % 3 == 0) line[n++] = '\t';
+        }
+        int count = rand() % 3 + 1;
+        for (int s = 0; s < count; s++) {
+            const char *syllable = syllables[rand() % 8];
+            line[n++] = rand() % 5 == 0 ? (char) toupper(syllable[0]) : syllable[0];
+            line[n++] = syllable[1];
+        }
+    }
+    int odd = rand() % 40;
+    if (odd == 0) line[n++] = '-';
+    else if (odd == 1) n = 0;
+    else if (odd == 2) {
+        while (n < MAX_WORD_LEN + 4) line[n++] = 'z';
+    }
+    if (rand() % 4 == 0) line[n++] = ' ';
+    line[n] = '\0';
+}
+
+static char *readFile(const char *path, long *outLength) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *data = malloc(length + 1);
+    if (data && fread(data, 1, length, file) != (size_t) length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    if (data) data[length] = '\0';
+    *outLength = length;
+    return data;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printf("usage: %s path/to/hangman_wordprep scratch_directory\n", argv[0]);
+        return 1;
+    }
+    const char *wordprep = argv[1];
+    const char *scratch = argv[2];
+    srand(argc > 3 ? (unsigned int) atoi(argv[3]) : 1);
+    mkdir(scratch, 0755);
+
+    char rawPath[1024];
+    snprintf(rawPath, sizeof(rawPath), "%s/syllables.raw", scratch);
+    FILE *raw = fopen(rawPath, "wb");
+    if (!raw) {
+        printf("[ERROR] Failed to write %s\n", rawPath);
+        return 1;
+    }
+    for (int i = 0; i < LINES; i++) {
+        char line[RAW_LINE_MAX];
+        makeLine(line);
+        expect(line);
+        fprintf(raw, "%s%s", line, i % 3 == 0 ? "\r\n" : "\n");
+    }
+    fclose(raw);
+
+    int failures = 0;
+    char *firstList = NULL, *firstDifficulty = NULL;
+    long firstListLength = 0, firstDifficultyLength = 0;
+
+    for (int t = 0; t < THREAD_COUNTS; t++) {
+        char outDir[1024], command[4096], path[1100];
+        snprintf(outDir, sizeof(outDir), "%s/j%d", scratch, threadCounts[t]);
+        mkdir(outDir, 0755);
+        snprintf(command, sizeof(command), "\"%s\" -j %d -o \"%s\" \"%s\" > /dev/null", wordprep, threadCounts[t],
+                 outDir, rawPath);
+        if (system(command) != 0) {
+            printf("[ERROR] %s failed\n", command);
+            failures++;
+            continue;
+        }
+
+        long listLength, difficultyLength;
+        snprintf(path, sizeof(path), "%s/syllables.txt", outDir);
+        char *list = readFile(path, &listLength);
+        snprintf(path, sizeof(path), "%s/syllables.difficulty", outDir);
+        char *difficulty = readFile(path, &difficultyLength);
+        if (!list || !difficulty) {
+            printf("[ERROR] -j %d left no list or no difficulty file in %s\n", threadCounts[t], outDir);
+            failures++;
+            free(list);
+            free(difficulty);
+            continue;
+        }
+
+        //the list has to be the reference word for word, LF after every word
+        long at = 0;
+        for (int i = 0; i < expectedCount && !failures; i++) {
+            size_t length = strlen(expected[i]);
+            if (at + (long) length >= listLength || memcmp(list + at, expected[i], length) != 0 ||
+                list[at + length] != '\n') {
+                printf("[ERROR] -j %d word %d is \"%.40s\", expected \"%s\"\n", threadCounts[t], i + 1,
+                       at < listLength ? list + at : "", expected[i]);
+                failures++;
+            }
+            at += (long) length + 1;
+        }
+        if (!failures && at != listLength) {
+            printf("[ERROR] -j %d kept more than the %d expected words\n", threadCounts[t], expectedCount);
+            failures++;
+        }
+
+        if (!firstList) {
+            firstList = list;
+            firstListLength = listLength;
+            firstDifficulty = difficulty;
+            firstDifficultyLength = difficultyLength;
+            continue;
+        }
+        if (listLength != firstListLength || memcmp(list, firstList, listLength) != 0 ||
+            difficultyLength != firstDifficultyLength || memcmp(difficulty, firstDifficulty, difficultyLength) != 0) {
+            printf("[ERROR] -j %d wrote other files than -j %d\n", threadCounts[t], threadCounts[0]);
+            failures++;
+        }
+        free(list);
+        free(difficulty);
+    }
+
+    free(firstList);
+    free(firstDifficulty);
+    printf("%d raw lines, %d words expected, %d failures\n", LINES, expectedCount, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,481 @@
+#include <ctype.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../game/hangman.h"
+#include "../game/word_difficulty.h"
+
+// turns raw word lists into the files the game loads from resources/words: one lower case word per line,
+// LF endings, single spaces, no duplicates, nothing the game can't play. Next to every list it writes the
+// difficulty of each word so the game doesn't have to run the solver at startup
+
+#define MAX_THREADS 64
+#define MAX_REJECT_EXAMPLES 5
+
+typedef enum {
+    LINE_OK,
+    LINE_EMPTY,
+    LINE_TOO_LONG,
+    LINE_BAD_CHAR,
+    LINE_DUPLICATE
+} LineStatus;
+
+// one line after normalisation, the text lives in the output buffer of the thread that handled it
+typedef struct {
+    const char *text;
+    int length;
+    uint32_t hash;
+    uint8_t status;
+    int lineNumber;
+} Entry;
+
+typedef struct {
+    const char *start;
+    const char *end;
+    int firstLine;
+    char *out;    // normalised words, each one NUL terminated
+    Entry *entries;
+    int entryCount;
+} Chunk;
+
+typedef struct {
+    Entry *entries;
+    int entryCount;
+    int shard;
+    int shardCount;
+} DedupJob;
+
+// the solver only compares words of the same length, so every job scores whole lengths on its own
+typedef struct {
+    const char *const *words;
+    const uint8_t *lengths;
+    int count;
+    const uint8_t *owner; // length -> job scoring it
+    int job;
+    WordDifficulty *out;
+    bool ok;
+} ScoreJob;
+
+static uint32_t hashWord(const char *word, int length) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= (unsigned char) word[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Normalises one raw line: trims it, collapses runs of blanks into one space and lower cases it
+ *
+ * @param line raw line without its line ending
+ * @param length length of the raw line
+ * @param out where the normalised word is written, needs length + 1 bytes
+ * @param outLength set to the length of the normalised word
+ * @return LINE_OK or the reason the word can't be used by the game
+ */
+static LineStatus normaliseLine(const char *line, int length, char *out, int *outLength) {
+    int n = 0;
+    bool pendingSpace = false;
+    bool badChar = false;
+
+    for (int i = 0; i < length; i++) {
+        unsigned char ch = (unsigned char) line[i];
+        if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\f' || ch == '\v') {
+            pendingSpace = n > 0;
+            continue;
+        }
+        if (pendingSpace) out[n++] = ' ';
+        pendingSpace = false;
+
+        // only letters can be guessed, anything else would leave a blank that can never be filled
+        if (ch < 128 && isalpha(ch)) out[n++] = (char) tolower(ch);
+        else {
+            out[n++] = (char) ch;
+            badChar = true;
+        }
+    }
+    out[n] = '\0';
+    *outLength = n;
+
+    if (n == 0) return LINE_EMPTY;
+    if (n >= MAX_WORD_LEN) return LINE_TOO_LONG;
+    if (badChar) return LINE_BAD_CHAR;
+    return LINE_OK;
+}
+
+static void *normaliseChunk(void *data) {
+    Chunk *chunk = data;
+    const char *line = chunk->start;
+    char *out = chunk->out;
+    int lineNumber = chunk->firstLine;
+
+    while (line < chunk->end) {
+        const char *newline = memchr(line, '\n', chunk->end - line);
+        const char *lineEnd = newline ? newline : chunk->end;
+
+        Entry *entry = &chunk->entries[chunk->entryCount++];
+        int length;
+        entry->status = (uint8_t) normaliseLine(line, (int) (lineEnd - line), out, &length);
+        entry->text = out;
+        entry->length = length;
+        entry->hash = hashWord(out, length);
+        entry->lineNumber = lineNumber++;
+        out += length + 1;
+
+        line = newline ? newline + 1 : chunk->end;
+    }
+    return NULL;
+}
+
+/**
+ * Marks every repeat of an earlier word as a duplicate. Each job only looks at the hashes of its own shard,
+ * so jobs never touch the same entry or the same table
+ */
+static void *dedupShard(void *data) {
+    DedupJob *job = data;
+
+    // skewed hashes can put far more than the average into one shard, so size the table from the real count
+    int shardEntries = 0;
+    for (int i = 0; i < job->entryCount; i++) {
+        const Entry *entry = &job->entries[i];
+        shardEntries += entry->status == LINE_OK && (int) (entry->hash % (uint32_t) job->shardCount) == job->shard;
+    }
+
+    int capacity = 1024;
+    while (capacity < shardEntries * 2 + 2) capacity *= 2;
+    const Entry **table = calloc(capacity, sizeof(Entry *));
+    if (!table) return (void *) 1;
+
+    for (int i = 0; i < job->entryCount; i++) {
+        Entry *entry = &job->entries[i];
+        if (entry->status != LINE_OK || (int) (entry->hash % (uint32_t) job->shardCount) != job->shard) continue;
+
+        // open addressing, at least twice as many slots as entries of this shard so a probe always ends on a
+        // free slot
+        uint32_t slot = (entry->hash / (uint32_t) job->shardCount) & (uint32_t) (capacity - 1);
+        while (table[slot]) {
+            const Entry *seen = table[slot];
+            if (seen->hash == entry->hash && seen->length == entry->length &&
+                memcmp(seen->text, entry->text, entry->length) == 0) {
+                entry->status = LINE_DUPLICATE;
+                break;
+            }
+            slot = (slot + 1) & (uint32_t) (capacity - 1);
+        }
+        if (entry->status == LINE_OK) table[slot] = entry;
+    }
+
+    free(table);
+    return NULL;
+}
+
+static void *scoreLengths(void *data) {
+    ScoreJob *job = data;
+    int n = 0;
+    for (int i = 0; i < job->count; i++) n += job->owner[job->lengths[i]] == job->job;
+    job->ok = true;
+    if (n == 0) return NULL;
+
+    const char **words = malloc(n * sizeof(char *));
+    int *ids = malloc(n * sizeof(int));
+    WordDifficulty *difficulty = malloc(n * sizeof(WordDifficulty));
+    job->ok = words && ids && difficulty;
+
+    if (job->ok) {
+        n = 0;
+        for (int i = 0; i < job->count; i++) {
+            if (job->owner[job->lengths[i]] != job->job) continue;
+            words[n] = job->words[i];
+            ids[n++] = i;
+        }
+        job->ok = wordDifficultyScore(words, n, difficulty);
+        for (int i = 0; i < n && job->ok; i++) job->out[ids[i]] = difficulty[i];
+    }
+
+    free(words);
+    free(ids);
+    free(difficulty);
+    return NULL;
+}
+
+/**
+ * Scores every kept word with the solver, spread over threads by word length, and writes <category>.difficulty
+ *
+ * @param words kept words in file order
+ * @param count number of words
+ * @param path file to write
+ * @param threadCount number of worker threads
+ * @return false if memory ran out or the file couldn't be written
+ */
+static bool writeDifficulty(const char *const *words, int count, const char *path, int threadCount) {
+    WordDifficulty *difficulty = malloc(count * sizeof(WordDifficulty));
+    uint8_t *lengths = malloc(count);
+    if (!difficulty || !lengths) {
+        free(difficulty);
+        free(lengths);
+        return false;
+    }
+
+    long long perLength[MAX_WORD_LEN] = {0};
+    for (int i = 0; i < count; i++) {
+        lengths[i] = (uint8_t) strlen(words[i]);
+        perLength[lengths[i]]++;
+    }
+
+    // largest length first onto the least loaded job, a group costs roughly its size
+    uint8_t owner[MAX_WORD_LEN] = {0};
+    long long load[MAX_THREADS] = {0};
+    bool assigned[MAX_WORD_LEN] = {false};
+    for (;;) {
+        int largest = -1;
+        for (int l = 0; l < MAX_WORD_LEN; l++) {
+            if (perLength[l] && !assigned[l] && (largest < 0 || perLength[l] > perLength[largest])) largest = l;
+        }
+        if (largest < 0) break;
+        int job = 0;
+        for (int t = 1; t < threadCount; t++) {
+            if (load[t] < load[job]) job = t;
+        }
+        owner[largest] = (uint8_t) job;
+        load[job] += perLength[largest];
+        assigned[largest] = true;
+    }
+
+    pthread_t threads[MAX_THREADS];
+    ScoreJob jobs[MAX_THREADS];
+    for (int t = 0; t < threadCount; t++) {
+        jobs[t] = (ScoreJob) {words, lengths, count, owner, t, difficulty, false};
+        pthread_create(&threads[t], NULL, scoreLengths, &jobs[t]);
+    }
+    bool ok = true;
+    for (int t = 0; t < threadCount; t++) {
+        pthread_join(threads[t], NULL);
+        if (!jobs[t].ok) ok = false;
+    }
+
+    ok = ok && wordDifficultySave(path, wordDifficultyHashWords(words, count), difficulty, count);
+    free(difficulty);
+    free(lengths);
+    return ok;
+}
+
+static char *readWholeFile(const char *path, long *outLen) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *buffer = len >= 0 ? malloc(len + 1) : NULL;
+    if (!buffer) {
+        fclose(file);
+        return NULL;
+    }
+    len = (long) fread(buffer, 1, len, file);
+    buffer[len] = '\0';
+    fclose(file);
+
+    *outLen = len;
+    return buffer;
+}
+
+// category name is the file name without directory and extension
+static void categoryFromPath(const char *path, char *out, size_t outSize) {
+    const char *name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+    snprintf(out, outSize, "%s", name);
+    char *dot = strrchr(out, '.');
+    if (dot && dot != out) *dot = '\0';
+}
+
+/**
+ * Runs the whole pipeline for one raw list and writes the cleaned list next to the others
+ *
+ * @param inputPath raw word list
+ * @param outputDir directory the cleaned list is written to
+ * @param threadCount number of worker threads
+ * @param totals counts per LineStatus, added to
+ * @return false if the file couldn't be read or written
+ */
+static bool processFile(const char *inputPath, const char *outputDir, int threadCount, long long totals[5]) {
+    long length;
+    char *data = readWholeFile(inputPath, &length);
+    if (!data) {
+        printf("[ERROR] Failed to read %s\n", inputPath);
+        return false;
+    }
+
+    // split at line boundaries, roughly the same number of bytes per thread
+    Chunk chunks[MAX_THREADS];
+    int chunkCount = 0;
+    const char *cursor = data;
+    const char *end = data + length;
+    int lineNumber = 1;
+    bool ok = true;
+
+    for (int t = 0; t < threadCount && cursor < end; t++) {
+        const char *chunkEnd = t == threadCount - 1 ? end : cursor + (end - cursor) / (threadCount - t);
+        if (chunkEnd < end) {
+            const char *newline = memchr(chunkEnd, '\n', end - chunkEnd);
+            chunkEnd = newline ? newline + 1 : end;
+        }
+
+        Chunk *chunk = &chunks[chunkCount++];
+        memset(chunk, 0, sizeof(Chunk));
+        chunk->start = cursor;
+        chunk->end = chunkEnd;
+        chunk->firstLine = lineNumber;
+
+        int lines = 0;
+        for (const char *p = cursor; p < chunkEnd; p++) lines += *p == '\n';
+        if (chunkEnd > cursor && chunkEnd[-1] != '\n') lines++;
+        lineNumber += lines;
+
+        // normalising never makes a line longer, so the raw size is enough
+        chunk->out = malloc((chunkEnd - cursor) + lines + 1);
+        chunk->entries = malloc((lines + 1) * sizeof(Entry));
+        if (!chunk->out || !chunk->entries) ok = false;
+        cursor = chunkEnd;
+    }
+
+    pthread_t threads[MAX_THREADS];
+    for (int t = 0; t < chunkCount && ok; t++) pthread_create(&threads[t], NULL, normaliseChunk, &chunks[t]);
+    for (int t = 0; t < chunkCount && ok; t++) pthread_join(threads[t], NULL);
+
+    // dedup needs every entry in file order, so gather them into one array
+    int entryCount = 0;
+    for (int t = 0; t < chunkCount; t++) entryCount += chunks[t].entryCount;
+    Entry *entries = ok ? malloc((entryCount + 1) * sizeof(Entry)) : NULL;
+    if (!entries) ok = false;
+
+    if (ok) {
+        int n = 0;
+        for (int t = 0; t < chunkCount; t++) {
+            memcpy(entries + n, chunks[t].entries, chunks[t].entryCount * sizeof(Entry));
+            n += chunks[t].entryCount;
+        }
+
+        DedupJob jobs[MAX_THREADS];
+        for (int t = 0; t < threadCount; t++) {
+            jobs[t] = (DedupJob) {entries, entryCount, t, threadCount};
+            pthread_create(&threads[t], NULL, dedupShard, &jobs[t]);
+        }
+        for (int t = 0; t < threadCount; t++) {
+            void *result;
+            pthread_join(threads[t], &result);
+            if (result) ok = false;
+        }
+    }
+
+    char category[256];
+    categoryFromPath(inputPath, category, sizeof(category));
+    char path[1024], tmpPath[1040];
+    snprintf(path, sizeof(path), "%s/%s.txt", outputDir, category);
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    long long counts[5] = {0};
+    int examples = 0;
+    FILE *out = ok ? fopen(tmpPath, "wb") : NULL;
+    if (ok && !out) printf("[ERROR] Failed to write %s\n", tmpPath);
+
+    if (out) {
+        for (int i = 0; i < entryCount; i++) {
+            Entry *entry = &entries[i];
+            counts[entry->status]++;
+
+            if (entry->status == LINE_OK) {
+                fwrite(entry->text, 1, entry->length, out);
+                fputc('\n', out);
+            } else if ((entry->status == LINE_BAD_CHAR || entry->status == LINE_TOO_LONG) &&
+                       examples++ < MAX_REJECT_EXAMPLES) {
+                printf("[WARNING] %s:%d rejected (%s): %.60s\n", inputPath, entry->lineNumber,
+                       entry->status == LINE_BAD_CHAR ? "not only letters and spaces" : "too long", entry->text);
+            }
+        }
+        bool written = fclose(out) == 0;
+        if (written && counts[LINE_OK] > 0) {
+            // the index goes first, so a running game reloading the new list already finds it
+            const char **kept = malloc(counts[LINE_OK] * sizeof(char *));
+            int keptCount = 0;
+            for (int i = 0; kept && i < entryCount; i++) {
+                if (entries[i].status == LINE_OK) kept[keptCount++] = entries[i].text;
+            }
+            char difficultyPath[1024];
+            snprintf(difficultyPath, sizeof(difficultyPath), "%s/%s.difficulty", outputDir, category);
+            if (!kept || !writeDifficulty(kept, keptCount, difficultyPath, threadCount)) {
+                printf("[WARNING] Failed to write %s, the game will rank %s by letter rarity only\n", difficultyPath,
+                       category);
+            }
+            free(kept);
+
+            ok = rename(tmpPath, path) == 0;
+        } else {
+            // never replace a list with an empty one, the game would lose the category
+            remove(tmpPath);
+            printf("[ERROR] %s has no usable words, %s left untouched\n", inputPath, path);
+            ok = false;
+        }
+    }
+
+    printf("%-24s %8d lines, %8lld kept, %6lld duplicates, %6lld rejected\n", category, entryCount,
+           counts[LINE_OK], counts[LINE_DUPLICATE], counts[LINE_BAD_CHAR] + counts[LINE_TOO_LONG]);
+    for (int s = 0; s < 5; s++) totals[s] += counts[s];
+
+    for (int t = 0; t < chunkCount; t++) {
+        free(chunks[t].out);
+        free(chunks[t].entries);
+    }
+    free(entries);
+    free(data);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    const char *outputDir = "resources/words";
+    int threadCount = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    int firstInput = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputDir = argv[++i];
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threadCount = atoi(argv[++i]);
+        else if (argv[i][0] == '-') {
+            firstInput = argc;
+            break;
+        } else {
+            firstInput = i;
+            break;
+        }
+    }
+    if (firstInput >= argc) {
+        printf("usage: %s [-j threads] [-o output directory] raw_list.txt...\n", argv[0]);
+        printf("each input becomes <output directory>/<input name>.txt, one category per file\n");
+        return 1;
+    }
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_THREADS) threadCount = MAX_THREADS;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    long long totals[5] = {0};
+    int failures = 0;
+    for (int i = firstInput; i < argc; i++) {
+        if (!processFile(argv[i], outputDir, threadCount, totals)) failures++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    long long lines = 0;
+    for (int s = 0; s < 5; s++) lines += totals[s];
+    printf("%lld lines in %.3fs (%.1f M lines/s) with %d threads, %lld words written\n", lines, seconds,
+           seconds > 0 ? lines / seconds / 1e6 : 0.0, threadCount, totals[LINE_OK]);
+
+    return failures ? 1 : 0;
+}
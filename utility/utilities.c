@@ -7,22 +7,162 @@
 #include <time.h>
 #include <stdbool.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+//sse2 is part of every x86-64 cpu, avx2 is only used when the cpu reports it at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTILITIES_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(UTILITIES_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTILITIES_AVX2 1
+#include <immintrin.h>
+#endif
+
+//categories found in resources/words, scanned on first use
+static char wordFileNameStorage[MAX_WORD_FILES][MAX_WORD_FILE_NAME];
+static char *wordFileNames[MAX_WORD_FILES];
+static int wordFileCount = -1;
+
+#ifdef UTILITIES_SSE2
+static SimdLevel simdLevel = SIMD_SSE2;
+#else
+static SimdLevel simdLevel = SIMD_SCALAR;
+#endif
+
+#ifdef UTILITIES_AVX2
+//runs before main so worker threads only ever read simdLevel
+__attribute__((constructor)) static void detectSimdLevel(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) simdLevel = SIMD_AVX2;
+}
+#endif
+
+/**
+ * Returns the instruction set the string helpers below currently use
+ *
+ * @return SIMD_AVX2, SIMD_SSE2 or SIMD_SCALAR
+ */
+SimdLevel getSimdLevel(void) {
+    return simdLevel;
+}
+
+/**
+ * Forces the string helpers onto a given instruction set, meant for benchmarks before any threads start
+ *
+ * @param level wanted level, lowered to the best one this cpu and build support
+ * @return level that is used from now on
+ */
+SimdLevel setSimdLevel(SimdLevel level) {
+    SimdLevel best = SIMD_SCALAR;
+#ifdef UTILITIES_SSE2
+    best = SIMD_SSE2;
+#endif
+#ifdef UTILITIES_AVX2
+    if (__builtin_cpu_supports("avx2")) best = SIMD_AVX2;
+#endif
+    simdLevel = level < best ? level : best;
+    return simdLevel;
+}
+
+/**
+ * Adds a file name to the list if it is a .txt file, keeping the list sorted
+ *
+ * @param fileName file name without directory
+ * @param names list of names without extension
+ * @param count number of names in the list, updated
+ * @param maxNames capacity of the list
+ */
+static void addWordFile(const char *fileName, char names[][MAX_WORD_FILE_NAME], int *count, int maxNames) {
+    size_t len = strlen(fileName);
+    if (len <= 4 || len - 4 >= MAX_WORD_FILE_NAME || strcmp(fileName + len - 4, ".txt") != 0) return;
+    if (*count >= maxNames) return;
+
+    char name[MAX_WORD_FILE_NAME];
+    memcpy(name, fileName, len - 4);
+    name[len - 4] = '\0';
+
+    //sorted so categories come out in the same order on every platform
+    int at = *count;
+    while (at > 0 && strcmp(names[at - 1], name) > 0) {
+        strcpy(names[at], names[at - 1]);
+        at--;
+    }
+    strcpy(names[at], name);
+    (*count)++;
+}
+
+/**
+ * Scans a directory for word files, every .txt file is one category
+ *
+ * @param directory directory to scan
+ * @param names filled with the file names without extension, sorted
+ * @param maxNames capacity of names
+ * @return number of names found, -1 if the directory can't be read
+ */
+int listWordFiles(const char *directory, char names[][MAX_WORD_FILE_NAME], int maxNames) {
+    int count = 0;
+
+#ifdef _WIN32
+    char pattern[512];
+    snprintf(pattern, sizeof(pattern), "%s\\*.txt", directory);
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA(pattern, &entry);
+    if (find == INVALID_HANDLE_VALUE) return GetLastError() == ERROR_FILE_NOT_FOUND ? 0 : -1;
+    do {
+        if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) addWordFile(entry.cFileName, names, &count, maxNames);
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR *dir = opendir(directory);
+    if (!dir) return -1;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        addWordFile(entry->d_name, names, &count, maxNames);
+    }
+    closedir(dir);
+#endif
+
+    return count;
+}
+
+/**
+ * Returns the names of all word files (categories) we have in our resources
+ *
+ * @param count set to the number of names in the returned array
+ * @return array of word file names without path or extension
+ */
+char **getWordFileNames(int *count) {
+    if (wordFileCount < 0) {
+        wordFileCount = listWordFiles("resources/words", wordFileNameStorage, MAX_WORD_FILES);
+        if (wordFileCount < 0) {
+            printf("[ERROR] Failed to read resources/words\n");
+            wordFileCount = 0;
+        }
+        for (int i = 0; i < wordFileCount; i++) {
+            wordFileNames[i] = wordFileNameStorage[i];
+        }
+    }
+
+    *count = wordFileCount;
+    return wordFileNames;
+}
+
 /**
  * Returns a random word representing the txt files we have in our resources
  *
- * @return random word from the local array words[]
+ * @return random word from the array returned by getWordFileNames(), NULL if there are no word files
  */
 char *getRandomWordFileName() {
-    char *words[] = {
-        "animals",
-        "continents",
-        "countries",
-        "fruits",
-        "planets",
-        "vegetables"
-    };
-
-    int word_count = sizeof(words) / sizeof(words[0]);
+    int word_count;
+    char **words = getWordFileNames(&word_count);
+    if (word_count == 0) return NULL;
     int random_index = rand() % word_count;
 
     return words[random_index];
@@ -35,6 +175,8 @@ char *getRandomWordFileName() {
  * @return random word from fileName file
  */
 char *getRandomWordFromFile(const char *fileName) {
+    if (!fileName) return NULL;
+
     //look for filename txt file inside resources folder
     char path[256];
     snprintf(path, sizeof(path), "resources/words/%s.txt", fileName);
@@ -45,43 +187,139 @@ char *getRandomWordFromFile(const char *fileName) {
         return NULL;
     }
 
-    //read all lines into array of strings
-    char *lines[256]; //max 256 lines possible
-    int lineCount = 0;
+    //rand is seeded once by the program, reseeding here with time(NULL) gave the same word within a second
+    //keep one line at random while reading instead of storing every line (reservoir sampling)
+    char selected[256];
     char buffer[256];
+    int lineCount = 0;
 
     while (fgets(buffer, sizeof(buffer), file)) {
         //remove new line characters
         buffer[strcspn(buffer, "\n")] = '\0';
 
-        //store each line
-        lines[lineCount] = malloc(strlen(buffer) + 1);
-        strcpy(lines[lineCount], buffer);
         lineCount++;
+        if (rand() % lineCount == 0) strcpy(selected, buffer);
 
-        if (lineCount >= 256) break; //prevent overflow
+        if (lineCount >= 256) break; //same limit as before
     }
 
     fclose(file);
 
     if (lineCount == 0) return NULL; //file would be empty
 
-    //choose random number
-    srand(time(NULL));
-    int random_index = rand() % (lineCount);
+    //only the chosen line is copied to the heap
+    char *selectedLine = malloc(strlen(selected) + 1);
+    if (selectedLine) strcpy(selectedLine, selected);
+    return selectedLine;
+}
 
-    //choose and copy the random line to return
-    char *selectedLine = malloc(strlen(lines[random_index]) + 1);
-    strcpy(selectedLine, lines[random_index]);
+// SIMD HELPERS
+// every helper works on whole blocks starting at *i and leaves *i at the first byte it didn't handle,
+// so avx2 hands the rest to sse2 and sse2 to the plain loop. Nothing past len is ever read or written
 
-    //free all others
-    for (int i = 0; i < lineCount; i++) {
-        free(lines[i]);
+#ifdef UTILITIES_AVX2
+__attribute__((target("avx2"))) static bool hasCharAvx2(const char *str, size_t len, char ch, size_t *i) {
+    __m256i needle = _mm256_set1_epi8(ch);
+    for (; *i + 32 <= len; *i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (str + *i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))) return true;
     }
+    return false;
+}
 
-    return selectedLine;
+__attribute__((target("avx2"))) static bool hasBlankAvx2(const char *str, size_t len, size_t *i) {
+    __m256i blank = _mm256_set1_epi8('_');
+    __m256i superBlank = _mm256_set1_epi8('~');
+    for (; *i + 32 <= len; *i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (str + *i));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, blank), _mm256_cmpeq_epi8(block, superBlank));
+        if (_mm256_movemask_epi8(hits)) return true;
+    }
+    return false;
 }
 
+__attribute__((target("avx2"))) static void toLowerAvx2(char *str, size_t len, size_t *i) {
+    __m256i beforeA = _mm256_set1_epi8('A' - 1);
+    __m256i afterZ = _mm256_set1_epi8('Z' + 1);
+    __m256i caseBit = _mm256_set1_epi8(0x20);
+    for (; *i + 32 <= len; *i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *) (str + *i));
+        // signed compares leave bytes above 127 alone, same as tolower in the C locale
+        __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(block, beforeA), _mm256_cmpgt_epi8(afterZ, block));
+        _mm256_storeu_si256((__m256i *) (str + *i), _mm256_or_si256(block, _mm256_and_si256(upper, caseBit)));
+    }
+}
+
+__attribute__((target("avx2"))) static void fillAvx2(char *str, size_t len, char ch, size_t *i) {
+    __m256i fill = _mm256_set1_epi8(ch);
+    for (; *i + 32 <= len; *i += 32) {
+        _mm256_storeu_si256((__m256i *) (str + *i), fill);
+    }
+}
+
+__attribute__((target("avx2"))) static void revealAvx2(const char *word, char *revealed, size_t len, char guess,
+                                                       size_t *i) {
+    __m256i needle = _mm256_set1_epi8(guess);
+    for (; *i + 32 <= len; *i += 32) {
+        __m256i letters = _mm256_loadu_si256((const __m256i *) (word + *i));
+        __m256i shown = _mm256_loadu_si256((const __m256i *) (revealed + *i));
+        __m256i match = _mm256_cmpeq_epi8(letters, needle);
+        _mm256_storeu_si256((__m256i *) (revealed + *i), _mm256_blendv_epi8(shown, letters, match));
+    }
+}
+#endif
+
+#ifdef UTILITIES_SSE2
+static bool hasCharSse2(const char *str, size_t len, char ch, size_t *i) {
+    __m128i needle = _mm_set1_epi8(ch);
+    for (; *i + 16 <= len; *i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (str + *i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))) return true;
+    }
+    return false;
+}
+
+static bool hasBlankSse2(const char *str, size_t len, size_t *i) {
+    __m128i blank = _mm_set1_epi8('_');
+    __m128i superBlank = _mm_set1_epi8('~');
+    for (; *i + 16 <= len; *i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (str + *i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, blank), _mm_cmpeq_epi8(block, superBlank));
+        if (_mm_movemask_epi8(hits)) return true;
+    }
+    return false;
+}
+
+static void toLowerSse2(char *str, size_t len, size_t *i) {
+    __m128i beforeA = _mm_set1_epi8('A' - 1);
+    __m128i afterZ = _mm_set1_epi8('Z' + 1);
+    __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; *i + 16 <= len; *i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (str + *i));
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, beforeA), _mm_cmplt_epi8(block, afterZ));
+        _mm_storeu_si128((__m128i *) (str + *i), _mm_or_si128(block, _mm_and_si128(upper, caseBit)));
+    }
+}
+
+static void fillSse2(char *str, size_t len, char ch, size_t *i) {
+    __m128i fill = _mm_set1_epi8(ch);
+    for (; *i + 16 <= len; *i += 16) {
+        _mm_storeu_si128((__m128i *) (str + *i), fill);
+    }
+}
+
+static void revealSse2(const char *word, char *revealed, size_t len, char guess, size_t *i) {
+    __m128i needle = _mm_set1_epi8(guess);
+    for (; *i + 16 <= len; *i += 16) {
+        __m128i letters = _mm_loadu_si128((const __m128i *) (word + *i));
+        __m128i shown = _mm_loadu_si128((const __m128i *) (revealed + *i));
+        __m128i match = _mm_cmpeq_epi8(letters, needle);
+        __m128i merged = _mm_or_si128(_mm_and_si128(match, letters), _mm_andnot_si128(match, shown));
+        _mm_storeu_si128((__m128i *) (revealed + *i), merged);
+    }
+}
+#endif
+
 /**
  * Converts the provided word completely to lower case
  *
@@ -89,8 +327,17 @@ char *getRandomWordFromFile(const char *fileName) {
  * @return word converted to lower case
  */
 char *stringToLower(char *word) {
-    //use tolower char function for entire string
-    for (int i = 0; word[i] != '\0'; i++) {
+    size_t len = strlen(word);
+    size_t i = 0;
+#ifdef UTILITIES_AVX2
+    if (simdLevel == SIMD_AVX2 && len >= 32) toLowerAvx2(word, len, &i);
+#endif
+#ifdef UTILITIES_SSE2
+    if (simdLevel >= SIMD_SSE2 && len - i >= 16) toLowerSse2(word, len, &i);
+#endif
+
+    //use tolower char function for the rest of the string
+    for (; i < len; i++) {
         word[i] = tolower(word[i]);
     }
     return word;
@@ -139,7 +386,16 @@ bool appendCharToArray(char array[], char ch, int *length, int maxLength) {
  * @return true if character exists in string, else false
  */
 bool stringHasChar(const char *str, char ch) {
-    for (int i = 0; str[i] != '\0'; i++) {
+    size_t len = strlen(str);
+    size_t i = 0;
+#ifdef UTILITIES_AVX2
+    if (simdLevel == SIMD_AVX2 && len >= 32 && hasCharAvx2(str, len, ch, &i)) return true;
+#endif
+#ifdef UTILITIES_SSE2
+    if (simdLevel >= SIMD_SSE2 && len - i >= 16 && hasCharSse2(str, len, ch, &i)) return true;
+#endif
+
+    for (; i < len; i++) {
         if (str[i] == ch) return true;
     }
     return false;
@@ -154,8 +410,16 @@ bool stringHasChar(const char *str, char ch) {
  */
 void copyStringToUnderscores(char *dest, const char *src) {
     // make blank version of the given string
-    int len = strlen(src);
-    for (int i = 0; i < len; i++) {
+    size_t len = strlen(src);
+    size_t i = 0;
+#ifdef UTILITIES_AVX2
+    if (simdLevel == SIMD_AVX2 && len >= 32) fillAvx2(dest, len, '_', &i);
+#endif
+#ifdef UTILITIES_SSE2
+    if (simdLevel >= SIMD_SSE2 && len - i >= 16) fillSse2(dest, len, '_', &i);
+#endif
+
+    for (; i < len; i++) {
         dest[i] = '_';
     }
     dest[len] = '\0';
@@ -169,7 +433,16 @@ void copyStringToUnderscores(char *dest, const char *src) {
  * @param guess the character that player guessed
  */
 void revealGuessedLetter(const char *word, char *revealed, char guess) {
-    for (int i = 0; word[i] != '\0'; i++) {
+    size_t len = strlen(word);
+    size_t i = 0;
+#ifdef UTILITIES_AVX2
+    if (simdLevel == SIMD_AVX2 && len >= 32) revealAvx2(word, revealed, len, guess, &i);
+#endif
+#ifdef UTILITIES_SSE2
+    if (simdLevel >= SIMD_SSE2 && len - i >= 16) revealSse2(word, revealed, len, guess, &i);
+#endif
+
+    for (; i < len; i++) {
         if (word[i] == guess) {
             revealed[i] = guess;
         }
@@ -183,7 +456,16 @@ void revealGuessedLetter(const char *word, char *revealed, char guess) {
  * @return true if word has even one _ or ~ else false
  */
 bool isWordFullyRevealed(const char *revealed) {
-    for (int i = 0; revealed[i] != '\0'; i++) {
+    size_t len = strlen(revealed);
+    size_t i = 0;
+#ifdef UTILITIES_AVX2
+    if (simdLevel == SIMD_AVX2 && len >= 32 && hasBlankAvx2(revealed, len, &i)) return false;
+#endif
+#ifdef UTILITIES_SSE2
+    if (simdLevel >= SIMD_SSE2 && len - i >= 16 && hasBlankSse2(revealed, len, &i)) return false;
+#endif
+
+    for (; i < len; i++) {
         if (revealed[i] == '_' || revealed[i] == '~') {
             return false; // still letters to guess
         }
@@ -2,6 +2,24 @@
 #define HANGMAN_UTILITIES_H
 #include <stdbool.h>
 
+//instruction sets the string helpers can use, picked at startup from what the cpu supports
+typedef enum {
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2
+} SimdLevel;
+
+SimdLevel getSimdLevel(void);
+
+SimdLevel setSimdLevel(SimdLevel level);
+
+#define MAX_WORD_FILES 64
+#define MAX_WORD_FILE_NAME 64
+
+int listWordFiles(const char *directory, char names[][MAX_WORD_FILE_NAME], int maxNames);
+
+char **getWordFileNames(int *count);
+
 char *getRandomWordFileName();
 
 char *getRandomWordFromFile(const char *fileName);